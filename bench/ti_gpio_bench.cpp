@@ -0,0 +1,1193 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Regression baseline of the library hot paths. Each operation is timed on its
+own and the report gives ops/s, the p50/p99/p999 latency and the heap
+allocations per operation:
+- setup() of an already requested line, which reconfigures it
+- input() and output() by channel, and Line::write()
+- output() of the value the line already drives, and toggle()
+- try_output() on a channel not set up as an output, the error path of the
+  noexcept API
+- input() of a mirrored input
+- output() of a list of channels
+- add_event_detect() dispatch, from an input edge to the callback
+- delivery of 100k edges per second, alone and while another thread keeps
+  adding and removing a callback of the line, which fails the bench when an
+  edge misses its callback or the p99 delay goes over --churn-max-delay
+- edge events dropped from bursts of 256 edges, with the default kernel
+  event buffer and with GPIO::EventBuffers asking for 1024 events
+- edges on four inputs of a gpiochip at once until all reach their
+  callback, with a line request per input and with merge_chip_requests()
+- the same edges until a thread looping on wait_for_edges() got them, which
+  fails the bench when that allocates, and output() while that thread is
+  blocked waiting
+- software PWM period and high time jitter, as measured by the PWM thread,
+  which fails the bench when the worst error goes over --pwm-tolerance
+- output() and input() from 1, 2, 4... threads each using its own line, then
+  with another thread reconfiguring a line with setup() meanwhile
+- output() of opposite values and toggle() from two threads on one line,
+  which fails the bench when a toggle is lost or the value the library knows
+  differs from the line afterwards
+- hardware PWM duty cycle writes through GPIO::SysfsAttr, against a fake
+  sysfs file so they run on any machine
+- PWM::ChangeDutyCycle() of a hardware PWM, when TI_GPIO_ROOT points to a
+  copy of a tree of bench/fixtures
+
+Without TI_GPIO_BACKEND the bench runs on the simulated backend, so the GPIO
+lines are simulated and no board is needed. Set TI_GPIO_BACKEND=gpiod to
+measure the lines of a board. Edge dispatch needs the simulated backend to
+drive the input and is skipped otherwise. The simulated backend also records
+the software PWM output, giving the percentiles of its period and high time
+errors.
+With TI_GPIO_ROOT set and TI_GPIO_SIM_MODEL unset, the simulated backend
+finds the board and its hardware PWMs under the root, the tree is written
+to so it should be a copy, on a tmpfs for instance.
+The latencies include the cost of reading the clock.
+The simulated lines share one lock, so the threaded runs scale only once
+--latency makes each access cost more than taking that lock.
+
+usage: ti_gpio_bench [options]
+    --iterations=N   operations per measurement (default 100000)
+    --pwm-seconds=S  software PWM run time (default 2)
+    --pwm-tolerance=US
+                     worst software PWM period or high time error
+                     (default 50)
+    --out=PIN        output pin (default 37)
+    --in=PIN         input pin (default 18)
+    --list=P,P,P,P   four pins of the list output (default 11,13,15,16)
+    --pwm=PIN        software PWM pin (default 35)
+    --hw-pwm=PIN     hardware PWM pin, with TI_GPIO_ROOT set (default 33)
+    --latency=NS     simulated cost of reading or writing a line (default 0)
+    --churn-seconds=S
+                     run time of the callback churn runs (default 1)
+    --churn-max-delay=US
+                     p99 delay from an edge to its callback in the churn
+                     runs (default 1000)
+    --threads=P,...  one pin per thread of the threaded runs
+                     (default 7,8,10,12,19,21,22,23)
+Pins use BOARD numbering.
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+#include <GPIO_sim.h>
+
+// Local headers
+#include "src/gpio_pwm_sysfs.h"
+
+using namespace std;
+
+static atomic<long> allocations{ 0 };
+
+/*
+The library finds the board model while it is statically initialised, which
+fails off a board. The simulated backend is made the default before that, by
+a constructor that runs ahead of the default priority initialisers.
+*/
+__attribute__( ( constructor( 101 ) ) ) static void default_backend( )
+{
+    setenv( "TI_GPIO_BACKEND", "sim", 0 );
+}
+
+void *operator new( size_t size )
+{
+    allocations++;
+    if( void *ptr = malloc( size ) )
+    {
+        return ptr;
+    }
+    throw bad_alloc( );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    free( ptr );
+}
+
+void operator delete( void *ptr, size_t ) noexcept
+{
+    free( ptr );
+}
+
+struct Options
+{
+    long        iterations{ 100000 };
+    int         pwm_seconds{ 2 };
+    double      pwm_tolerance_us{ 50.0 };
+    int         out_pin{ 37 };
+    int         in_pin{ 18 };
+    vector<int> list_pins{ 11, 13, 15, 16 };
+    int         pwm_pin{ 35 };
+    int         hw_pwm_pin{ 33 };
+    uint64_t    latency_ns{ 0 };
+    int         churn_seconds{ 1 };
+    double      churn_max_delay_us{ 1000.0 };
+    vector<int> thread_pins{ 7, 8, 10, 12, 19, 21, 22, 23 };
+};
+
+static vector<int> parse_pins( const string &value )
+{
+    vector<int>  pins{ };
+    stringstream ss( value );
+    string       pin;
+    while( getline( ss, pin, ',' ) )
+    {
+        pins.push_back( atoi( pin.c_str( ) ) );
+    }
+
+    return pins;
+}
+
+static Options parse( int argc, char *argv[] )
+{
+    Options options;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        string arg   = argv[i];
+        size_t eq    = arg.find( '=' );
+        string key   = arg.substr( 0, eq );
+        string value = eq == string::npos ? "" : arg.substr( eq + 1 );
+
+        if( key == "--iterations" )
+        {
+            options.iterations = atol( value.c_str( ) );
+        }
+        else if( key == "--pwm-seconds" )
+        {
+            options.pwm_seconds = atoi( value.c_str( ) );
+        }
+        else if( key == "--pwm-tolerance" )
+        {
+            options.pwm_tolerance_us = atof( value.c_str( ) );
+        }
+        else if( key == "--out" )
+        {
+            options.out_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--in" )
+        {
+            options.in_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--hw-pwm" )
+        {
+            options.hw_pwm_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--pwm" )
+        {
+            options.pwm_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--latency" )
+        {
+            options.latency_ns = strtoull( value.c_str( ), nullptr, 10 );
+        }
+        else if( key == "--churn-seconds" )
+        {
+            options.churn_seconds = atoi( value.c_str( ) );
+        }
+        else if( key == "--churn-max-delay" )
+        {
+            options.churn_max_delay_us = atof( value.c_str( ) );
+        }
+        else if( key == "--threads" )
+        {
+            options.thread_pins = parse_pins( value );
+        }
+        else if( key == "--list" )
+        {
+            options.list_pins = parse_pins( value );
+            if( options.list_pins.size( ) != 4 )
+            {
+                cerr << "--list takes four pins" << endl;
+                exit( -1 );
+            }
+        }
+        else
+        {
+            cerr << "Unknown option " << arg << endl;
+            exit( -1 );
+        }
+    }
+
+    return options;
+}
+
+static uint64_t now_ns( )
+{
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now( ).time_since_epoch( ) )
+        .count( );
+}
+
+static void print_percentiles( const string &name, vector<uint64_t> &samples )
+{
+    if( samples.empty( ) )
+    {
+        return;
+    }
+
+    sort( samples.begin( ), samples.end( ) );
+    auto percentile = [&]( double p ) {
+        return samples[min( samples.size( ) - 1,
+                            size_t( samples.size( ) * p ) )];
+    };
+
+    cout << "    " << left << setw( 14 ) << name << right << "p50 "
+         << percentile( 0.50 ) << " ns, p99 " << percentile( 0.99 )
+         << " ns, p999 " << percentile( 0.999 ) << " ns" << endl;
+}
+
+static void print_header( )
+{
+    cout << left << setw( 26 ) << "operation" << right << setw( 12 )
+         << "ops/s" << setw( 10 ) << "p50 ns" << setw( 10 ) << "p99 ns"
+         << setw( 10 ) << "p999 ns" << setw( 12 ) << "allocs/op" << endl;
+}
+
+/*
+Time iterations calls of op, after a warm up of a tenth of them. samples is
+allocated by the caller so it isn't counted as an allocation of op.
+Returns the number of allocations per operation.
+*/
+template <typename Op>
+static double measure( const string &name, long iterations,
+                       vector<uint64_t> &samples, Op &&op )
+{
+    for( long i = 0; i < iterations / 10; i++ )
+    {
+        op( i );
+    }
+
+    long     allocs_before = allocations;
+    uint64_t start         = now_ns( );
+    for( long i = 0; i < iterations; i++ )
+    {
+        uint64_t t0 = now_ns( );
+        op( i );
+        samples[i] = now_ns( ) - t0;
+    }
+    uint64_t elapsed = now_ns( ) - start;
+    long     allocs  = allocations - allocs_before;
+
+    sort( samples.begin( ), samples.begin( ) + iterations );
+    auto percentile = [&]( double p ) {
+        return samples[min( iterations - 1, long( iterations * p ) )];
+    };
+
+    double allocs_per_op = double( allocs ) / iterations;
+
+    cout << left << setw( 26 ) << name << right << fixed << setprecision( 0 )
+         << setw( 12 ) << iterations * 1e9 / elapsed << setw( 10 )
+         << percentile( 0.50 ) << setw( 10 ) << percentile( 0.99 )
+         << setw( 10 ) << percentile( 0.999 ) << setprecision( 3 )
+         << setw( 12 ) << allocs_per_op << endl;
+
+    return allocs_per_op;
+}
+
+static atomic<unsigned long> dispatched{ 0 };
+
+static void                  on_edges( const GPIO::EdgeEventSpan &events )
+{
+    dispatched += events.size( );
+}
+
+// Time from driving the simulated input to the end of its callback
+static double bench_event_dispatch( const Options    &options,
+                                    vector<uint64_t> &samples )
+{
+    GPIO::setup( options.in_pin, GPIO::IN );
+    GPIO::add_event_detect( options.in_pin, GPIO::BOTH, on_edges );
+
+    double allocs_per_op =
+        measure( "add_event_detect dispatch", options.iterations, samples,
+                 [&]( long i ) {
+                     unsigned long expected = dispatched + 1;
+                     GPIO::sim::set_input( options.in_pin,
+                                           ( i & 1 ) == 0 ? GPIO::HIGH
+                                                          : GPIO::LOW );
+                     while( dispatched < expected )
+                     {
+                         this_thread::yield( );
+                     }
+                 } );
+
+    GPIO::remove_event_detect( options.in_pin );
+    return allocs_per_op;
+}
+
+// Written by the event thread only, read once the line is no longer watched
+static vector<uint64_t> churn_delays{ };
+static size_t           churn_count{ 0 };
+static unsigned long    churn_missed{ 0 };
+static unsigned long    churn_last_seqno{ 0 };
+
+static void             on_churn_edges( const GPIO::EdgeEventSpan &events )
+{
+    uint64_t now = now_ns( );
+    for( const GPIO::EdgeEvent &event : events )
+    {
+        if( churn_count < churn_delays.size( ) )
+        {
+            churn_delays[churn_count++] = now - event.timestamp_ns;
+        }
+
+        if( churn_last_seqno != 0 && event.line_seqno != churn_last_seqno + 1 )
+        {
+            churn_missed += event.line_seqno - churn_last_seqno - 1;
+        }
+        churn_last_seqno = event.line_seqno;
+    }
+}
+
+static void on_churn_extra( int )
+{
+}
+
+struct ChurnResult
+{
+    unsigned long missed;
+    uint64_t      p99_delay_ns;
+};
+
+/*
+A 50 kHz square wave gives 100k edges per second on the simulated input,
+for churn_seconds. A callback records the delay from each edge to its
+dispatch and the edges it missed. With churn, another thread keeps adding
+and removing a second callback of the line meanwhile, which must not delay
+the dispatch. The kernel buffer holds 10 ms of edges, so the event thread
+being scheduled out for a while doesn't miss any.
+*/
+static ChurnResult run_callback_churn( const Options &options, bool churn )
+{
+    churn_delays.assign( size_t( options.churn_seconds ) * 200000, 0 );
+    churn_count      = 0;
+    churn_missed     = 0;
+    churn_last_seqno = 0;
+
+    GPIO::EventBuffers buffers{ };
+    buffers.kernel_events = 1024;
+    GPIO::add_event_detect( options.in_pin, GPIO::BOTH, on_churn_edges, 0,
+                            buffers );
+
+    atomic<bool>     done{ false };
+    unsigned long    registrations = 0;
+    vector<uint64_t> registration_ns( 1000000 );
+    thread           churner{ };
+    if( churn )
+    {
+        churner = thread( [&] {
+            while( !done )
+            {
+                uint64_t start = now_ns( );
+                GPIO::add_event_callback( options.in_pin, on_churn_extra );
+                GPIO::remove_event_callback( options.in_pin, on_churn_extra );
+                registration_ns[registrations % registration_ns.size( )] =
+                    now_ns( ) - start;
+                registrations++;
+            }
+        } );
+    }
+
+    uint64_t start = now_ns( );
+    GPIO::sim::play( options.in_pin,
+                     { { GPIO::HIGH, 10000 }, { GPIO::LOW, 10000 } }, true );
+    this_thread::sleep_for( chrono::seconds( options.churn_seconds ) );
+    GPIO::sim::stop( options.in_pin );
+    uint64_t elapsed = now_ns( ) - start;
+
+    done = true;
+    if( churner.joinable( ) )
+    {
+        churner.join( );
+    }
+    GPIO::remove_event_detect( options.in_pin );
+
+    cout << ( churn ? "with churn" : "alone" ) << ": " << fixed
+         << setprecision( 0 ) << churn_count * 1e9 / elapsed
+         << " events/s delivered, " << churn_missed << " missed";
+    if( churn )
+    {
+        cout << ", " << registrations * 1e9 / elapsed
+             << " add + remove/s";
+    }
+    cout << endl;
+
+    churn_delays.resize( churn_count );
+    print_percentiles( "dispatch", churn_delays );
+    if( churn )
+    {
+        registration_ns.resize(
+            min<size_t>( registrations, registration_ns.size( ) ) );
+        print_percentiles( "add + remove", registration_ns );
+    }
+
+    ChurnResult result{ churn_missed, 0 };
+    if( !churn_delays.empty( ) )
+    {
+        result.p99_delay_ns = churn_delays[min(
+            churn_delays.size( ) - 1, size_t( churn_delays.size( ) * 0.99 ) )];
+    }
+    return result;
+}
+
+static atomic<unsigned long> burst_dispatched{ 0 };
+
+static void on_burst_edges( const GPIO::EdgeEventSpan &events )
+{
+    burst_dispatched += events.size( );
+}
+
+/*
+Bursts of 256 edges played back to back on the simulated input, faster than
+the event thread wakes up. Returns the events dropped by the kernel buffer.
+*/
+static unsigned long run_burst( const Options            &options,
+                                const GPIO::EventBuffers &buffers )
+{
+    vector<GPIO::sim::WaveformStep> steps{ };
+    for( int i = 0; i < 256; i++ )
+    {
+        steps.push_back( { ( i & 1 ) == 0 ? GPIO::HIGH : GPIO::LOW, 0 } );
+    }
+
+    burst_dispatched = 0;
+    GPIO::sim::set_input( options.in_pin, GPIO::LOW );
+    GPIO::add_event_detect( options.in_pin, GPIO::BOTH, on_burst_edges, 0,
+                            buffers );
+
+    for( int i = 0; i < 10; i++ )
+    {
+        GPIO::sim::play( options.in_pin, steps, false );
+        GPIO::sim::wait_waveforms( );
+        this_thread::sleep_for( chrono::milliseconds( 10 ) );
+    }
+
+    unsigned long dropped = GPIO::events_dropped( options.in_pin );
+    GPIO::remove_event_detect( options.in_pin );
+
+    cout << left << setw( 26 )
+         << ( buffers.kernel_events == 0
+                  ? string( "default buffer" )
+                  : to_string( buffers.kernel_events ) + " events" )
+         << right << setw( 12 ) << burst_dispatched << setw( 12 ) << dropped
+         << endl;
+    return dropped;
+}
+
+static atomic<unsigned long> fan_in_dispatched{ 0 };
+
+static void on_fan_in_edges( const GPIO::EdgeEventSpan &events )
+{
+    fan_in_dispatched += events.size( );
+}
+
+/*
+Edges on several inputs of a gpiochip at once, until all of them reached
+their callback. The inputs are read from one fd per line request.
+*/
+static void run_fan_in( const Options &options, const string &name,
+                        const vector<int> &pins, vector<uint64_t> &samples )
+{
+    for( int pin : pins )
+    {
+        GPIO::setup( pin, GPIO::IN );
+        GPIO::sim::set_input( pin, GPIO::LOW );
+        GPIO::add_event_detect( pin, GPIO::BOTH, on_fan_in_edges );
+    }
+
+    int level = GPIO::LOW;
+    measure( name, options.iterations, samples, [&]( long ) {
+        unsigned long expected = fan_in_dispatched + pins.size( );
+        level                  = level == GPIO::LOW ? GPIO::HIGH : GPIO::LOW;
+        for( int pin : pins )
+        {
+            GPIO::sim::set_input( pin, level );
+        }
+
+        while( fan_in_dispatched < expected )
+        {
+            this_thread::yield( );
+        }
+    } );
+
+    for( int pin : pins )
+    {
+        GPIO::remove_event_detect( pin );
+    }
+}
+
+/*
+The first half of the threaded run pins get a line request each, then the
+second half is set up with merge_chip_requests(), merging the requests of
+their gpiochip. The pins must all be on the same gpiochip.
+*/
+static void bench_fan_in( const Options &options, vector<uint64_t> &samples )
+{
+    size_t      half = options.thread_pins.size( ) / 2;
+    vector<int> separate( options.thread_pins.begin( ),
+                          options.thread_pins.begin( ) + half );
+    vector<int> merged( options.thread_pins.begin( ) + half,
+                        options.thread_pins.begin( ) + 2 * half );
+
+    run_fan_in( options, to_string( half ) + " inputs, own requests",
+                separate, samples );
+
+    GPIO::merge_chip_requests( );
+    run_fan_in( options, to_string( half ) + " inputs, merged", merged,
+                samples );
+    GPIO::merge_chip_requests( false );
+}
+
+/*
+Edges on the inputs of the fan-in run, until a thread looping on
+wait_for_edges() got all of them, then output() while that thread is blocked
+waiting, which takes no lock it holds.
+Returns the allocations per edge delivery, the thread reuses its events.
+*/
+static double bench_wait_for_edges( const Options    &options,
+                                  vector<uint64_t> &samples )
+{
+    size_t      half = options.thread_pins.size( ) / 2;
+    vector<int> pins( options.thread_pins.begin( ),
+                      options.thread_pins.begin( ) + half );
+    for( int pin : pins )
+    {
+        GPIO::setup( pin, GPIO::IN );
+        GPIO::sim::set_input( pin, GPIO::LOW );
+    }
+
+    // The lines keep detecting the edges once armed, none is missed before
+    // the thread first waits
+    GPIO::wait_for_edges( pins, GPIO::BOTH, 0, 0 );
+
+    atomic<unsigned long> received{ 0 };
+    atomic_bool           stop{ false };
+    thread                waiter( [&] {
+        vector<GPIO::EdgeEvent> events{ };
+        while( !stop )
+        {
+            GPIO::wait_for_edges( pins, GPIO::BOTH, events, 0, 10 );
+            received += events.size( );
+        }
+    } );
+
+    int    level  = GPIO::LOW;
+    double allocs = measure(
+        "wait_for_edges " + to_string( half ) + " inputs", options.iterations,
+        samples, [&]( long ) {
+            unsigned long expected = received + pins.size( );
+            level = level == GPIO::LOW ? GPIO::HIGH : GPIO::LOW;
+            for( int pin : pins )
+            {
+                GPIO::sim::set_input( pin, level );
+            }
+
+            while( received < expected )
+            {
+                this_thread::yield( );
+            }
+        } );
+
+    measure( "output, thread waiting", options.iterations, samples,
+             [&]( long i ) { GPIO::output( options.out_pin, int( i & 1 ) ); } );
+
+    stop = true;
+    waiter.join( );
+
+    return allocs;
+}
+
+/*
+Errors of the period and high time of the recorded PWM output. Every write
+of the PWM thread is recorded, edges are the writes changing the value.
+*/
+static void print_recorded_pwm( const vector<GPIO::sim::OutputSample> &writes,
+                                uint64_t period_ns, uint64_t high_ns )
+{
+    vector<uint64_t> period_errors{ };
+    vector<uint64_t> high_errors{ };
+
+    auto             error = []( uint64_t measured, uint64_t expected ) {
+        return measured > expected ? measured - expected : expected - measured;
+    };
+
+    uint64_t last_rise = 0;
+    for( size_t i = 1; i < writes.size( ); i++ )
+    {
+        const auto &prev = writes[i - 1];
+        const auto &cur  = writes[i];
+
+        if( prev.value == GPIO::LOW && cur.value == GPIO::HIGH )
+        {
+            if( last_rise != 0 )
+            {
+                period_errors.push_back(
+                    error( cur.timestamp_ns - last_rise, period_ns ) );
+            }
+            last_rise = cur.timestamp_ns;
+        }
+        else if( prev.value == GPIO::HIGH && cur.value == GPIO::LOW &&
+                 last_rise != 0 )
+        {
+            high_errors.push_back(
+                error( cur.timestamp_ns - last_rise, high_ns ) );
+        }
+    }
+
+    cout << "    recorded output, " << writes.size( ) << " writes" << endl;
+    print_percentiles( "period error", period_errors );
+    print_percentiles( "high error", high_errors );
+}
+
+// Returns the worst period or high time error, in nanoseconds
+static uint64_t bench_sw_pwm( const Options &options )
+{
+    GPIO::setup( options.pwm_pin, GPIO::OUT, GPIO::LOW );
+
+    if( GPIO::sim::enabled( ) )
+    {
+        // Two writes per period, with room for the start up
+        GPIO::sim::record( options.pwm_pin,
+                           2000 * size_t( options.pwm_seconds + 1 ) );
+    }
+
+    GPIO::PwmStats stats;
+    long           allocs;
+    {
+        GPIO::PWM pwm( options.pwm_pin, 1000 );
+        pwm.start( 50.0 );
+
+        // Skip the start up of the PWM thread
+        this_thread::sleep_for( chrono::milliseconds( 100 ) );
+        pwm.ResetStats( );
+
+        long allocs_before = allocations;
+        this_thread::sleep_for( chrono::seconds( options.pwm_seconds ) );
+        stats  = pwm.GetStats( );
+        allocs = allocations - allocs_before;
+
+        pwm.stop( );
+    }
+
+    cout << "software PWM 1 kHz 50 %: " << stats.periods << " periods, "
+         << stats.overruns << " overruns, " << fixed << setprecision( 3 )
+         << ( stats.periods ? double( allocs ) / stats.periods : 0.0 )
+         << " allocs/period" << endl;
+    cout << setprecision( 0 ) << "    period  mean " << stats.period_mean_ns
+         << " ns, stddev " << stats.period_stddev_ns << " ns, max error "
+         << stats.period_max_error_ns << " ns" << endl;
+    cout << "    high    mean " << stats.high_mean_ns << " ns, stddev "
+         << stats.high_stddev_ns << " ns, max error "
+         << stats.high_max_error_ns << " ns" << endl;
+    cout << "    worst wake up " << stats.wakeup_max_late_ns << " ns late"
+         << endl;
+
+    if( GPIO::sim::enabled( ) )
+    {
+        print_recorded_pwm( GPIO::sim::recorded( options.pwm_pin ), 1000000,
+                            500000 );
+    }
+
+    return max( stats.period_max_error_ns, stats.high_max_error_ns );
+}
+
+static void bench_hw_pwm_duty( const Options    &options,
+                               vector<uint64_t> &samples )
+{
+    char dir_template[] = "/tmp/ti_gpio_bench.XXXXXX";
+    if( mkdtemp( dir_template ) == nullptr )
+    {
+        cerr << "Could not create the fake sysfs directory" << endl;
+        return;
+    }
+
+    string dir             = dir_template;
+    string duty_cycle_path = dir + "/duty_cycle";
+    {
+        ofstream f( duty_cycle_path );
+        f << 0 << endl;
+    }
+
+    {
+        GPIO::SysfsAttr duty_cycle;
+        duty_cycle.open( duty_cycle_path );
+
+        measure( "HW PWM duty (fake sysfs)", options.iterations, samples,
+                 [&]( long i ) { duty_cycle.write( 500000 + ( i & 1 ) ); } );
+    }
+
+    unlink( duty_cycle_path.c_str( ) );
+    rmdir( dir.c_str( ) );
+}
+
+/*
+Duty cycle changes of a hardware PWM found under TI_GPIO_ROOT, through the
+whole PWM path of the library down to the sysfs attribute
+*/
+static void bench_hw_pwm_channel( const Options    &options,
+                                  vector<uint64_t> &samples )
+{
+    GPIO::PWM pwm( options.hw_pwm_pin, 1000 );
+    pwm.start( 0 );
+
+    measure( "HW PWM ChangeDutyCycle", options.iterations, samples,
+             [&]( long i ) { pwm.ChangeDutyCycle( ( i & 1 ) ? 75 : 25 ); } );
+
+    pwm.stop( );
+}
+
+/*
+Each thread writes its own output line and reads it back, by channel
+number. input() and output() take no lock, so the throughput should grow
+with the threads until the cores or the GPIO driver are saturated.
+With churn, one more thread keeps reconfiguring the output pin meanwhile.
+Returns the number of reads not giving the value just written.
+*/
+static long run_threads( const Options &options, size_t count, bool churn,
+                         double &ops_per_s )
+{
+    atomic<bool>     go{ false };
+    atomic<bool>     done{ false };
+    atomic<long>     mismatches{ 0 };
+    vector<uint64_t> elapsed( count );
+    vector<thread>   threads{ };
+
+    for( size_t t = 0; t < count; t++ )
+    {
+        threads.emplace_back( [&, t] {
+            int pin = options.thread_pins[t];
+            while( !go )
+            {
+            }
+
+            uint64_t start = now_ns( );
+            for( long i = 0; i < options.iterations; i++ )
+            {
+                GPIO::output( pin, int( i & 1 ) );
+                if( GPIO::input( pin ) != int( i & 1 ) )
+                {
+                    mismatches++;
+                }
+            }
+            elapsed[t] = now_ns( ) - start;
+        } );
+    }
+
+    thread churner{ };
+    if( churn )
+    {
+        churner = thread( [&] {
+            for( long i = 0; !done; i++ )
+            {
+                GPIO::setup( options.out_pin, GPIO::OUT, int( i & 1 ) );
+            }
+        } );
+    }
+
+    go = true;
+    for( auto &t : threads )
+    {
+        t.join( );
+    }
+
+    done = true;
+    if( churner.joinable( ) )
+    {
+        churner.join( );
+    }
+
+    uint64_t longest = *max_element( elapsed.begin( ), elapsed.end( ) );
+    ops_per_s        = 2.0 * options.iterations * count * 1e9 / longest;
+    return mismatches;
+}
+
+static long bench_threads( const Options &options )
+{
+    for( int pin : options.thread_pins )
+    {
+        GPIO::setup( pin, GPIO::OUT, GPIO::LOW );
+    }
+
+    cout << "threads, output() and input() of their own line" << endl;
+    cout << left << setw( 26 ) << "threads" << right << setw( 12 )
+         << "ops/s" << setw( 10 ) << "speedup" << endl;
+
+    long   mismatches = 0;
+    double single     = 0;
+    size_t max        = options.thread_pins.size( );
+    for( size_t count = 1; count <= max; count = min( count * 2, max + 1 ) )
+    {
+        for( bool churn : { false, true } )
+        {
+            double ops_per_s = 0;
+            mismatches += run_threads( options, count, churn, ops_per_s );
+            if( count == 1 && !churn )
+            {
+                single = ops_per_s;
+            }
+
+            string name = to_string( count ) + ( churn ? " + setup()" : "" );
+            cout << left << setw( 26 ) << name << right << fixed
+                 << setprecision( 0 ) << setw( 12 ) << ops_per_s
+                 << setprecision( 2 ) << setw( 10 ) << ops_per_s / single
+                 << endl;
+        }
+
+        if( count == max )
+        {
+            break;
+        }
+    }
+
+    return mismatches;
+}
+
+/*
+Whether the value the library knows a line drives is the value of the line:
+writing it again must be skipped, writing the other one must not.
+*/
+static bool known_value_matches( int pin )
+{
+    int level = GPIO::input( pin );
+
+    GPIO::reset_output_stats( );
+    GPIO::output( pin, level );
+    GPIO::OutputStats same = GPIO::output_stats( );
+
+    GPIO::reset_output_stats( );
+    GPIO::output( pin, level == GPIO::HIGH ? GPIO::LOW : GPIO::HIGH );
+    GPIO::OutputStats other = GPIO::output_stats( );
+
+    return same.elided == 1 && other.writes == 1;
+}
+
+/*
+Rounds where two threads each call write( thread ) once, followed by check.
+Returns the number of rounds check failed and the rounds per second.
+*/
+template <typename Write, typename Check>
+static long run_shared_rounds( long rounds, Write write, Check check,
+                               double &rounds_per_s )
+{
+    atomic<long>   round{ 0 };
+    atomic<long>   written{ 0 };
+    vector<thread> threads{ };
+    for( int t : { 0, 1 } )
+    {
+        threads.emplace_back( [&, t] {
+            for( long r = 1; r <= rounds; r++ )
+            {
+                while( round < r )
+                {
+                    this_thread::yield( );
+                }
+
+                write( t );
+                written++;
+            }
+        } );
+    }
+
+    long     failed = 0;
+    uint64_t start  = now_ns( );
+    for( long r = 1; r <= rounds; r++ )
+    {
+        round = r;
+        while( written < 2 * r )
+        {
+            this_thread::yield( );
+        }
+
+        if( !check( ) )
+        {
+            failed++;
+        }
+    }
+    rounds_per_s = rounds * 1e9 / ( now_ns( ) - start );
+
+    for( auto &t : threads )
+    {
+        t.join( );
+    }
+
+    return failed;
+}
+
+/*
+Two threads writing opposite values to the same line, then toggling it. A
+write and the value known of the line must change together, or the writes
+skipped afterwards leave the line at a value nobody asked for, and a toggle
+must not lose the write of the other thread. Both are checked after every
+round, where each thread writes or toggles once.
+Returns the number of rounds that failed.
+*/
+static long bench_shared_line( const Options &options )
+{
+    int  pin    = options.out_pin;
+    long rounds = max( options.iterations / 100, 1L );
+    GPIO::setup( pin, GPIO::OUT, GPIO::LOW );
+
+    cout << "one line, two threads" << endl;
+    cout << left << setw( 26 ) << "writes" << right << setw( 12 )
+         << "rounds/s" << setw( 12 ) << "failed" << endl;
+
+    // Forced, so that both writes race every round
+    double rounds_per_s = 0;
+    long   output_failed = run_shared_rounds(
+        rounds, [&]( int t ) { GPIO::output( pin, t, true ); },
+        [&] { return known_value_matches( pin ); }, rounds_per_s );
+
+    cout << left << setw( 26 ) << "output" << right << fixed
+         << setprecision( 0 ) << setw( 12 ) << rounds_per_s << setw( 12 )
+         << output_failed << endl;
+
+    // Two toggles leave the line at its level
+    int  level         = GPIO::input( pin );
+    long toggle_failed = run_shared_rounds(
+        rounds, [&]( int ) { GPIO::toggle( pin ); },
+        [&] {
+            bool ok = GPIO::input( pin ) == level && known_value_matches( pin );
+            level   = GPIO::input( pin );
+            return ok;
+        },
+        rounds_per_s );
+
+    cout << left << setw( 26 ) << "toggle" << right << fixed
+         << setprecision( 0 ) << setw( 12 ) << rounds_per_s << setw( 12 )
+         << toggle_failed << endl;
+
+    return output_failed + toggle_failed;
+}
+
+int main( int argc, char *argv[] )
+{
+    Options options = parse( argc, argv );
+
+    GPIO::setwarnings( false );
+    GPIO::setmode( GPIO::BOARD );
+
+    bool simulated = GPIO::sim::enabled( );
+    if( simulated )
+    {
+        GPIO::sim::Latency latency;
+        latency.get_ns = options.latency_ns;
+        latency.set_ns = options.latency_ns;
+        GPIO::sim::set_latency( latency );
+    }
+
+    cout << "model: " << GPIO::model
+         << ( simulated ? " (simulated)" : "" ) << endl;
+    cout << "iterations: " << options.iterations << endl << endl;
+
+    vector<uint64_t> samples( options.iterations );
+
+    print_header( );
+
+    GPIO::Line out = GPIO::setup( options.out_pin, GPIO::OUT, GPIO::LOW );
+
+    measure( "setup", options.iterations, samples, [&]( long i ) {
+        GPIO::setup( options.out_pin, GPIO::OUT, int( i & 1 ) );
+    } );
+
+    measure( "output", options.iterations, samples, [&]( long i ) {
+        GPIO::output( options.out_pin, int( i & 1 ) );
+    } );
+
+    measure( "Line::write", options.iterations, samples,
+             [&]( long i ) { out.write( int( i & 1 ) ); } );
+
+    GPIO::reset_output_stats( );
+    measure( "output unchanged", options.iterations, samples,
+             [&]( long ) { GPIO::output( options.out_pin, GPIO::HIGH ); } );
+
+    GPIO::OutputStats stats = GPIO::output_stats( );
+    cout << "    " << stats.writes << " writes, " << stats.elided
+         << " elided" << endl;
+
+    measure( "toggle", options.iterations, samples,
+             [&]( long ) { GPIO::toggle( options.out_pin ); } );
+
+    volatile GPIO::Status status = GPIO::Status::OK;
+    measure( "try_output error", options.iterations, samples, [&]( long ) {
+        status = GPIO::try_output( options.in_pin, GPIO::HIGH );
+    } );
+
+    GPIO::setup( options.in_pin, GPIO::IN );
+
+    volatile int sink = 0;
+    measure( "input", options.iterations, samples,
+             [&]( long ) { sink = sink + GPIO::input( options.in_pin ); } );
+
+    GPIO::mirror_input( options.in_pin );
+    measure( "input mirrored", options.iterations, samples,
+             [&]( long ) { sink = sink + GPIO::input( options.in_pin ); } );
+    GPIO::mirror_input( options.in_pin, false );
+
+    const vector<int> &l = options.list_pins;
+    GPIO::setup( { l[0], l[1], l[2], l[3] }, GPIO::OUT, GPIO::LOW );
+
+    measure( "output list", options.iterations, samples, [&]( long i ) {
+        GPIO::output( { l[0], l[1], l[2], l[3] }, int( i & 1 ) );
+    } );
+
+    measure( "toggle list", options.iterations, samples,
+             [&]( long ) { GPIO::toggle( { l[0], l[1], l[2], l[3] } ); } );
+
+    double        dispatch_allocs = 0;
+    double        wait_allocs     = 0;
+    unsigned long burst_dropped   = 0;
+    ChurnResult   churn_alone{ 0, 0 };
+    ChurnResult   churn_busy{ 0, 0 };
+    if( simulated )
+    {
+        dispatch_allocs = bench_event_dispatch( options, samples );
+    }
+    else
+    {
+        cout << left << setw( 26 ) << "add_event_detect dispatch"
+             << "skipped, needs TI_GPIO_BACKEND=sim" << endl;
+    }
+
+    bench_hw_pwm_duty( options, samples );
+
+    if( getenv( "TI_GPIO_ROOT" ) != nullptr )
+    {
+        bench_hw_pwm_channel( options, samples );
+    }
+
+    if( simulated )
+    {
+        cout << endl << "callbacks, 100k edges/s" << endl;
+        GPIO::sim::set_input( options.in_pin, GPIO::LOW );
+        churn_alone = run_callback_churn( options, false );
+        churn_busy  = run_callback_churn( options, true );
+
+        cout << endl << "bursts of 256 edges" << endl;
+        cout << left << setw( 26 ) << "kernel buffer" << right << setw( 12 )
+             << "delivered" << setw( 12 ) << "dropped" << endl;
+
+        GPIO::EventBuffers buffers{ };
+        run_burst( options, buffers );
+        buffers.kernel_events = 1024;
+        buffers.read_events   = 256;
+        burst_dropped         = run_burst( options, buffers );
+
+        cout << endl;
+        print_header( );
+        bench_fan_in( options, samples );
+        wait_allocs = bench_wait_for_edges( options, samples );
+    }
+
+    cout << endl;
+    uint64_t pwm_error_ns = bench_sw_pwm( options );
+
+    cout << endl;
+    long mismatches = bench_threads( options );
+
+    cout << endl;
+    long differs = bench_shared_line( options );
+
+    GPIO::cleanup( );
+
+    if( dispatch_allocs != 0 )
+    {
+        cerr << "FAILED: edge event dispatch allocates" << endl;
+        return 1;
+    }
+
+    if( wait_allocs != 0 )
+    {
+        cerr << "FAILED: wait_for_edges() into a reused vector allocates"
+             << endl;
+        return 1;
+    }
+
+    if( churn_alone.missed != 0 || churn_busy.missed != 0 )
+    {
+        cerr << "FAILED: " << churn_alone.missed + churn_busy.missed
+             << " edges missed their callback at 100k edges/s" << endl;
+        return 1;
+    }
+
+    uint64_t churn_delay_ns =
+        max( churn_alone.p99_delay_ns, churn_busy.p99_delay_ns );
+    if( churn_delay_ns > options.churn_max_delay_us * 1000 )
+    {
+        cerr << "FAILED: p99 callback delay of " << churn_delay_ns / 1000.0
+             << " us at 100k edges/s, over the " << options.churn_max_delay_us
+             << " us bound" << endl;
+        return 1;
+    }
+
+    if( burst_dropped != 0 )
+    {
+        cerr << "FAILED: " << burst_dropped << " edge events dropped with a "
+             << "1024 events kernel buffer" << endl;
+        return 1;
+    }
+
+    if( pwm_error_ns > options.pwm_tolerance_us * 1000 )
+    {
+        cerr << "FAILED: software PWM error of " << pwm_error_ns / 1000.0
+             << " us, over the " << options.pwm_tolerance_us
+             << " us tolerance" << endl;
+        return 1;
+    }
+
+    if( mismatches != 0 )
+    {
+        cerr << "FAILED: " << mismatches << " threaded reads did not return "
+             << "the value written" << endl;
+        return 1;
+    }
+
+    if( differs != 0 )
+    {
+        cerr << "FAILED: " << differs << " rounds of two threads writing "
+             << "one line left it at another value than written or known"
+             << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,409 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+Startup cost of a process linking ti_gpio, like a CLI tool flipping one
+relay. The bench spawns itself once per run, the child sets up one output
+and reports back. The report gives, over all the runs:
+- the time from spawning the process to the return of its first setup(),
+  static initialization of the library included
+- the heap allocations made and the bytes allocated until then, and the
+  bytes still allocated once setup() returned
+- the maximum resident set size of the process
+
+With --pwm the children also create a hardware PWM before reporting, which
+looks up the sysfs directory of its PWM chip.
+With --cache the processes keep the board they found in a board cache file,
+see TI_GPIO_BOARD_CACHE. The runs are made once with the file removed before
+each process starts, then again with the file the previous runs wrote.
+The simulated backend names its board, so discovery only runs against a
+fake /proc and /sys: a copy of a tree of bench/fixtures set as TI_GPIO_ROOT.
+
+With TI_GPIO_BACKEND=sim the GPIO lines are simulated and no board is
+needed, the environment is passed on to the children.
+
+usage: TI_GPIO_BACKEND=sim ti_gpio_startup_bench [options]
+    --runs=N   processes started (default 200)
+    --out=PIN  output pin set up by the processes (default 37)
+    --pwm=PIN  hardware PWM pin also used by the processes (default none)
+    --cache=FILE
+               compare startup without and with a board cache in FILE
+Pins use BOARD numbering.
+*/
+
+#include <malloc.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+
+using namespace std;
+
+extern char **environ;
+
+// Counted from the start of the process, static initialization included
+static atomic<long> allocations{ 0 };
+static atomic<long> allocated_bytes{ 0 };
+static atomic<long> live_bytes{ 0 };
+
+// Kept out of line: once inlined in a replaced operator delete, GCC sees
+// free() release what operator new returned and warns of a mismatch
+__attribute__( ( noinline ) ) static void *_allocate( size_t size,
+                                                      size_t alignment )
+{
+    void *ptr = alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                    ? malloc( size )
+                    : aligned_alloc( alignment,
+                                     ( size + alignment - 1 ) / alignment *
+                                         alignment );
+    if( ptr != nullptr )
+    {
+        long usable = long( malloc_usable_size( ptr ) );
+        allocations++;
+        allocated_bytes += usable;
+        live_bytes += usable;
+    }
+    return ptr;
+}
+
+__attribute__( ( noinline ) ) static void _release( void *ptr )
+{
+    if( ptr != nullptr )
+    {
+        live_bytes -= long( malloc_usable_size( ptr ) );
+    }
+    free( ptr );
+}
+
+void *operator new( size_t size )
+{
+    if( void *ptr = _allocate( size, 0 ) )
+    {
+        return ptr;
+    }
+    throw bad_alloc( );
+}
+
+void *operator new( size_t size, align_val_t alignment )
+{
+    if( void *ptr = _allocate( size, size_t( alignment ) ) )
+    {
+        return ptr;
+    }
+    throw bad_alloc( );
+}
+
+void *operator new( size_t size, const nothrow_t & ) noexcept
+{
+    return _allocate( size, 0 );
+}
+
+void *operator new( size_t size, align_val_t alignment,
+                    const nothrow_t & ) noexcept
+{
+    return _allocate( size, size_t( alignment ) );
+}
+
+void *operator new[]( size_t size )
+{
+    return operator new( size );
+}
+
+void *operator new[]( size_t size, align_val_t alignment )
+{
+    return operator new( size, alignment );
+}
+
+void operator delete( void *ptr ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete( void *ptr, size_t ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete( void *ptr, align_val_t ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete( void *ptr, size_t, align_val_t ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete[]( void *ptr ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete[]( void *ptr, size_t ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete[]( void *ptr, align_val_t ) noexcept
+{
+    _release( ptr );
+}
+
+void operator delete[]( void *ptr, size_t, align_val_t ) noexcept
+{
+    _release( ptr );
+}
+
+struct Options
+{
+    int    runs{ 200 };
+    int    out_pin{ 37 };
+    int    pwm_pin{ 0 };
+    string cache{ };
+};
+
+// What a child reports once its first setup() returned
+struct Report
+{
+    uint64_t done_ns;
+    long     allocations;
+    long     allocated_bytes;
+    long     live_bytes;
+};
+
+static Options parse( int argc, char *argv[] )
+{
+    Options options;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        string arg   = argv[i];
+        size_t eq    = arg.find( '=' );
+        string key   = arg.substr( 0, eq );
+        string value = eq == string::npos ? "" : arg.substr( eq + 1 );
+
+        if( key == "--runs" )
+        {
+            options.runs = max( 1, atoi( value.c_str( ) ) );
+        }
+        else if( key == "--out" )
+        {
+            options.out_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--pwm" )
+        {
+            options.pwm_pin = atoi( value.c_str( ) );
+        }
+        else if( key == "--cache" )
+        {
+            options.cache = value;
+        }
+        else if( key != "--child" )
+        {
+            cerr << "Unknown option " << arg << endl;
+            exit( -1 );
+        }
+    }
+
+    return options;
+}
+
+static uint64_t now_ns( )
+{
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::steady_clock::now( ).time_since_epoch( ) )
+        .count( );
+}
+
+// Set up the output and write the report to stdout, which is a pipe
+static int run_child( const Options &options )
+{
+    // The PWMs of a fixture tree are already exported
+    GPIO::setwarnings( false );
+    GPIO::setmode( GPIO::BOARD );
+    GPIO::setup( options.out_pin, GPIO::OUT, GPIO::LOW );
+
+    unique_ptr<GPIO::PWM> pwm{ };
+    if( options.pwm_pin != 0 )
+    {
+        pwm = make_unique<GPIO::PWM>( options.pwm_pin, 1000 );
+    }
+
+    Report report{ now_ns( ), allocations, allocated_bytes, live_bytes };
+    pwm.reset( );
+
+    GPIO::cleanup( );
+    return write( STDOUT_FILENO, &report, sizeof( report ) ) ==
+                   sizeof( report )
+               ? 0
+               : 1;
+}
+
+/*
+Start the bench as a child, returning its report and its maximum resident
+set size in KiB, with done_ns made relative to the spawn
+*/
+static bool spawn_child( const Options &options, Report &report,
+                         long &max_rss_kb )
+{
+    int fds[2];
+    if( pipe( fds ) == -1 )
+    {
+        return false;
+    }
+
+    string                     runs = "--runs=1";
+    string                     out  = "--out=" + to_string( options.out_pin );
+    string                     pwm  = "--pwm=" + to_string( options.pwm_pin );
+    string                     child = "--child";
+    char                       exe[] = "/proc/self/exe";
+    vector<char *>             args{ exe,         child.data( ), runs.data( ),
+                         out.data( ), pwm.data( ),   nullptr };
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init( &actions );
+    posix_spawn_file_actions_adddup2( &actions, fds[1], STDOUT_FILENO );
+    posix_spawn_file_actions_addclose( &actions, fds[0] );
+
+    pid_t    pid;
+    uint64_t start = now_ns( );
+    int      err   = posix_spawn( &pid, exe, &actions, nullptr, args.data( ),
+                                  environ );
+    posix_spawn_file_actions_destroy( &actions );
+    close( fds[1] );
+    if( err != 0 )
+    {
+        close( fds[0] );
+        return false;
+    }
+
+    ssize_t got = read( fds[0], &report, sizeof( report ) );
+    close( fds[0] );
+
+    int           status;
+    struct rusage usage{ };
+    wait4( pid, &status, 0, &usage );
+    max_rss_kb = usage.ru_maxrss;
+
+    report.done_ns -= start;
+    return got == sizeof( report ) && WIFEXITED( status ) &&
+           WEXITSTATUS( status ) == 0;
+}
+
+/*
+Start options.runs children and print the report of name. With cold set the
+board cache is removed before each child starts.
+*/
+static bool run( const Options &options, const string &name, bool cold )
+{
+    vector<uint64_t> startup{ };
+    vector<long>     rss{ };
+    Report           last{ };
+    for( int i = 0; i < options.runs; i++ )
+    {
+        if( cold )
+        {
+            unlink( options.cache.c_str( ) );
+        }
+
+        long max_rss_kb = 0;
+        if( !spawn_child( options, last, max_rss_kb ) )
+        {
+            cerr << "FAILED: the child process did not set up pin "
+                 << options.out_pin << endl;
+            return false;
+        }
+
+        startup.push_back( last.done_ns );
+        rss.push_back( max_rss_kb );
+    }
+
+    sort( startup.begin( ), startup.end( ) );
+    sort( rss.begin( ), rss.end( ) );
+    auto percentile = [&]( double p ) {
+        return startup[min( startup.size( ) - 1,
+                            size_t( startup.size( ) * p ) )];
+    };
+
+    cout << endl << name << endl;
+    cout << left << setw( 26 )
+         << ( options.pwm_pin != 0 ? "spawn to setup() + PWM"
+                                   : "spawn to first setup()" )
+         << right
+         << "p50 " << percentile( 0.50 ) / 1000 << " us, p99 "
+         << percentile( 0.99 ) / 1000 << " us" << endl;
+    cout << left << setw( 26 ) << "heap until then" << right
+         << last.allocations << " allocations, " << last.allocated_bytes
+         << " bytes" << endl;
+    cout << left << setw( 26 ) << "heap then" << right
+         << last.live_bytes << " bytes live" << endl;
+    cout << left << setw( 26 ) << "max RSS" << right
+         << rss[rss.size( ) / 2] << " KiB (p50)" << endl;
+
+    return true;
+}
+
+int main( int argc, char *argv[] )
+{
+    Options options = parse( argc, argv );
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( string( argv[i] ) == "--child" )
+        {
+            return run_child( options );
+        }
+    }
+
+    cout << "runs: " << options.runs << endl;
+
+    if( options.cache.empty( ) )
+    {
+        return run( options, "no board cache", false ) ? 0 : 1;
+    }
+
+    // Passed on to the children
+    setenv( "TI_GPIO_BOARD_CACHE", options.cache.c_str( ), 1 );
+
+    bool ok = run( options, "board cache cold", true ) &&
+              run( options, "board cache warm", false );
+    unlink( options.cache.c_str( ) );
+    return ok ? 0 : 1;
+}
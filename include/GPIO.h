@@ -29,9 +29,13 @@ DEALINGS IN THE SOFTWARE.
 #define _GPIO_H
 
 // standard headers
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory> // for pImpl
+#include <new>
 #include <type_traits>
+#include <vector>
 
 // library headers
 #include <gpiod.h>
@@ -107,6 +111,45 @@ namespace GPIO
     constexpr Edge FALLING = Edge::FALLING;
     constexpr Edge BOTH    = Edge::BOTH;
 
+    //--------------STATUS-------------------------------------
+
+    /*
+    Errors of the noexcept API. The functions whose name starts with try_
+    never throw, print or terminate the process, they return a Status
+    instead. BUSY and INTERRUPTED are transient, the call can be retried.
+    */
+    enum class Status
+    {
+        OK,
+        MODE_NOT_SET,     // setmode() has not been called
+        INVALID_CHANNEL,  // not a channel of the numbering mode
+        NOT_SET_UP,       // the channel has not been set up
+        NOT_INPUT,        // the channel is not set up as an input
+        NOT_OUTPUT,       // the channel is not set up as an output
+        NOT_DETECTING,    // add_event_detect() has not been called
+        PWM_IN_USE,       // the channel is running as PWM
+        NOT_GPIO,         // a hardware PWM pin, driven through GPIO::PWM
+        NOT_FOUND,        // the callback was not added to the channel
+        INVALID_ARGUMENT,
+        BUSY,             // EBUSY, the line is used by another consumer
+        INTERRUPTED,      // EINTR
+        NO_MEMORY,
+        IO_ERROR          // any other error of the GPIO driver
+    };
+
+    // Message of a status, as printed by the functions that don't return it
+    const char *status_string( Status status ) noexcept;
+
+    // Value returned by a try_ function, only meaningful when ok()
+    template <class T> struct Result
+    {
+        Status status;
+        T      value;
+
+        bool   ok( ) const noexcept { return status == Status::OK; }
+        explicit operator bool( ) const noexcept { return ok( ); }
+    };
+
     // Function used to enable/disable warnings during setup and cleanup.
     void setwarnings( bool state );
 
@@ -119,14 +162,71 @@ namespace GPIO
     // Function used to get the currently set pin numbering mode
     NumberingModes getmode( );
 
+    /*
+    Function used to merge the line requests of each gpiochip, disabled by
+    default. Once enabled, lines set up on a gpiochip where this process
+    already requested lines join them in a single line request. The edge
+    events of all its lines are then read from one file descriptor and
+    dispatched by line offset, which saves file descriptors and wakeups of
+    the event thread when many inputs of a bank fire together.
+    The kernel can't add lines to a request, so setting up a line requests
+    the lines of its gpiochip again: outputs keep their value, and other
+    threads using these lines wait for that setup() to finish. Lines waited
+    on by wait_for_edges() keep their own request.
+    */
+    void merge_chip_requests( bool enable = true );
+
+    //--------------LINE HANDLE--------------------------------
+
+    class LineState;
+
+    /*
+    Handle to a channel, returned by setup().
+    The channel lookup is done once by setup(), so read() and write() go
+    straight to the requested line without any per-call lookup or allocation.
+    The handle follows later setup() and cleanup() calls on the same channel.
+    A default constructed handle, or one returned by a failed setup(),
+    is not valid.
+    */
+    class Line
+    {
+      public:
+        Line( ) = default;
+        explicit Line( LineState *state ); // used by setup()
+
+        // Same as GPIO::input() on the channel
+        int        read( ) const;
+
+        // Same as GPIO::output() on the channel
+        void       write( int value, bool force = false ) const;
+
+        // Same as GPIO::toggle() on the channel
+        void       toggle( ) const;
+
+        // Same as read(), write() and toggle(), returning errors instead
+        Result<int> try_read( ) const noexcept;
+        Status      try_write( int value, bool force = false ) const noexcept;
+        Status      try_toggle( ) const noexcept;
+
+        // Direction the channel is currently set up for in this process
+        Directions direction( ) const;
+
+        bool       valid( ) const;
+
+      private:
+        LineState *pImpl{ nullptr };
+    };
+
     /*
     Function used to setup individual pins as Input or Output.
     direction must be IN or OUT, initial must be
-    HIGH or LOW and is only valid when direction is OUT
+    HIGH or LOW and is only valid when direction is OUT.
+    Returns a handle for fast access to the channel. A hardware PWM pin isn't
+    set up as a GPIO, it is left to GPIO::PWM and an invalid handle returned.
     */
-    void setup( const std::string &channel, Directions direction,
+    Line setup( const std::string &channel, Directions direction,
                 int initial = -1 );
-    void setup( int channel, Directions direction, int initial = -1 );
+    Line setup( int channel, Directions direction, int initial = -1 );
     template <typename T>
     void setup( const std::initializer_list<T> &channels, Directions direction,
                 int initial = -1 );
@@ -141,14 +241,43 @@ namespace GPIO
     /*
     Function used to set a value to a channel.
     Values must be either HIGH or LOW
+    The line is not written when it already drives the value, unless force
+    is set.
     */
-    void output( const std::string &channel, int value );
-    void output( int channel, int value );
+    void output( const std::string &channel, int value, bool force = false );
+    void output( int channel, int value, bool force = false );
     template <typename T>
-    void output( const std::initializer_list<T> &channels, int value );
+    void output( const std::initializer_list<T> &channels, int value,
+                 bool force = false );
     template <typename T>
     void output( const std::initializer_list<T>   &channels,
-                 const std::initializer_list<int> &values );
+                 const std::initializer_list<int> &values,
+                 bool                              force = false );
+
+    /*
+    Function used to invert the value of a channel set up as an output.
+    The channels of a list are written with one call per gpiochip. The value
+    is read and its inverse written as one step, so toggles of the same
+    channel from several threads are never lost.
+    */
+    void toggle( const std::string &channel );
+    void toggle( int channel );
+    template <typename T>
+    void toggle( const std::initializer_list<T> &channels );
+
+    /*
+    Writes made by output(), toggle(), Line::write() and Line::toggle() since
+    the last reset_output_stats(). elided counts the writes skipped because
+    the line already drove the value.
+    */
+    struct OutputStats
+    {
+        unsigned long long writes;
+        unsigned long long elided;
+    };
+
+    OutputStats output_stats( );
+    void        reset_output_stats( );
 
     /*
     Function used to check the currently set function
@@ -175,62 +304,287 @@ namespace GPIO
     template <class T>
     constexpr bool is_equality_comparable_v = is_equality_comparable<T>::value;
 
+    //--------------EDGE EVENTS--------------------------------
+
+    /*
+    Edge event as reported by the kernel. timestamp_ns is taken by the kernel
+    when the edge is detected, so pulse widths and intervals computed from it
+    don't include the scheduling latency of the event thread.
+    */
+    struct EdgeEvent
+    {
+        uint64_t      timestamp_ns; // CLOCK_MONOTONIC, in nanoseconds
+        Edge          edge;         // RISING or FALLING
+        unsigned long line_seqno;   // sequence number of the event on the line
+        unsigned long global_seqno; // sequence number within the line request
+        unsigned int  offset;       // line offset within the gpiochip
+        int           channel;      // channel given to add_event_detect()
+    };
+
+    /*
+    Events read from the kernel in one batch, oldest first.
+    Only valid during the callback it is passed to.
+    */
+    class EdgeEventSpan
+    {
+      public:
+        EdgeEventSpan( const EdgeEvent *events, size_t count )
+            : m_events( events ), m_count( count )
+        {
+        }
+
+        const EdgeEvent *begin( ) const { return m_events; }
+        const EdgeEvent *end( ) const { return m_events + m_count; }
+        size_t           size( ) const { return m_count; }
+        bool             empty( ) const { return m_count == 0; }
+
+        const EdgeEvent &operator[]( size_t index ) const
+        {
+            return m_events[index];
+        }
+
+      private:
+        const EdgeEvent *m_events;
+        size_t           m_count;
+    };
+
     //--------------CALLBACK--------------------------------
 
     class Callback;
     bool operator==( const Callback &A, const Callback &B );
     bool operator!=( const Callback &A, const Callback &B );
 
+    /*
+    Callback run by the event thread. The callable may take:
+    - int: the channel, called once per event
+    - const EdgeEvent &: the event record, called once per event
+    - const EdgeEventSpan &: all the events of a batch, called once per batch
+
+    Callables of up to INLINE_SIZE bytes (function pointers, small functors,
+    lambdas capturing a few pointers) are stored inside the Callback itself,
+    bigger ones are allocated once when the Callback is created. Running a
+    callback never allocates.
+    */
     class Callback
     {
+      public:
+        static constexpr size_t INLINE_SIZE = 4 * sizeof( void * );
+
       private:
-        using func_t = std::function<void( int )>;
+        using storage_t =
+            std::aligned_storage_t<INLINE_SIZE, alignof( std::max_align_t )>;
 
-        template <class T>
-        static bool comparer_impl( const func_t &A, const func_t &B )
+        // Type erased operations on the stored callable
+        struct Ops
         {
-            static_assert(
-                is_equality_comparable_v<const T &>,
-                "Callback function MUST be equality comparable. ex> f0 == f1" );
+            void ( *invoke )( storage_t &self, const EdgeEventSpan &events );
+            void ( *copy )( storage_t &dst, const storage_t &src );
+            void ( *move )( storage_t &dst, storage_t &src ) noexcept;
+            void ( *destroy )( storage_t &self ) noexcept;
+            bool ( *equal )( const storage_t &A, const storage_t &B );
+        };
+
+        template <class T> struct Model
+        {
+            static constexpr bool is_inline =
+                sizeof( T ) <= sizeof( storage_t ) &&
+                alignof( T ) <= alignof( storage_t ) &&
+                std::is_nothrow_move_constructible_v<T>;
+
+            static T &get( storage_t &self )
+            {
+                if constexpr( is_inline )
+                {
+                    return *std::launder( reinterpret_cast<T *>( &self ) );
+                }
+                else
+                {
+                    return **reinterpret_cast<T **>( &self );
+                }
+            }
 
-            if( A == nullptr && B == nullptr )
+            static const T &get( const storage_t &self )
             {
-                return true;
+                return get( const_cast<storage_t &>( self ) );
             }
 
-            const T *targetA = A.target<T>( );
-            const T *targetB = B.target<T>( );
+            template <class U> static void create( storage_t &self, U &&target )
+            {
+                if constexpr( is_inline )
+                {
+                    ::new( &self ) T( std::forward<U>( target ) );
+                }
+                else
+                {
+                    *reinterpret_cast<T **>( &self ) =
+                        new T( std::forward<U>( target ) );
+                }
+            }
 
-            return targetA != nullptr && targetB != nullptr &&
-                   *targetA == *targetB;
-        }
+            // Passes the events to the target in the form it accepts
+            static void invoke( storage_t &self, const EdgeEventSpan &events )
+            {
+                T &target = get( self );
+
+                if constexpr( std::is_invocable_v<T &, const EdgeEventSpan &> )
+                {
+                    target( events );
+                }
+                else if constexpr( std::is_invocable_v<T &, const EdgeEvent &> )
+                {
+                    for( const EdgeEvent &event : events )
+                    {
+                        target( event );
+                    }
+                }
+                else
+                {
+                    for( const EdgeEvent &event : events )
+                    {
+                        target( event.channel );
+                    }
+                }
+            }
+
+            static void copy( storage_t &dst, const storage_t &src )
+            {
+                create( dst, get( src ) );
+            }
+
+            static void move( storage_t &dst, storage_t &src ) noexcept
+            {
+                if constexpr( is_inline )
+                {
+                    ::new( &dst ) T( std::move( get( src ) ) );
+                    get( src ).~T( );
+                }
+                else
+                {
+                    dst = src;
+                }
+            }
+
+            static void destroy( storage_t &self ) noexcept
+            {
+                if constexpr( is_inline )
+                {
+                    get( self ).~T( );
+                }
+                else
+                {
+                    delete &get( self );
+                }
+            }
+
+            static bool equal( const storage_t &A, const storage_t &B )
+            {
+                static_assert( is_equality_comparable_v<const T &>,
+                               "Callback function MUST be equality "
+                               "comparable. ex> f0 == f1" );
+
+                return get( A ) == get( B );
+            }
+
+            // One instance per type, so equal Ops pointers mean equal types
+            static constexpr Ops ops{ invoke, copy, move, destroy, equal };
+        };
 
       public:
-        template <class T, class = std::enable_if_t<
-                               !std::is_same<std::decay_t<T>, Callback>::value>>
+        Callback( std::nullptr_t = nullptr ) {}
+
+        template <class T,
+                  class = std::enable_if_t<
+                      !std::is_same_v<std::decay_t<T>, Callback> &&
+                      !std::is_same_v<std::decay_t<T>, std::nullptr_t>>>
         Callback( T &&function )
-            : function( std::forward<T>( function ) ),
-              comparer( []( const func_t &A, const func_t &B ) {
-                  return comparer_impl<std::decay_t<T>>( A, B );
-              } )
         {
-            static_assert( std::is_constructible<func_t, T &&>::value,
-                           "Callback return type: void, argument type: int" );
+            using target_t = std::decay_t<T>;
+
+            static_assert(
+                std::is_invocable_v<target_t &, int> ||
+                    std::is_invocable_v<target_t &, const EdgeEvent &> ||
+                    std::is_invocable_v<target_t &, const EdgeEventSpan &>,
+                "Callback return type: void, argument type: int, "
+                "const EdgeEvent & or const EdgeEventSpan &" );
+
+            if constexpr( std::is_pointer_v<std::remove_reference_t<T>> )
+            {
+                if( function == nullptr )
+                {
+                    return;
+                }
+            }
+
+            Model<target_t>::create( storage, std::forward<T>( function ) );
+            ops = &Model<target_t>::ops;
+        }
+
+        Callback( const Callback &other ) : ops( other.ops )
+        {
+            if( ops != nullptr )
+            {
+                ops->copy( storage, other.storage );
+            }
+        }
+
+        Callback( Callback &&other ) noexcept : ops( other.ops )
+        {
+            if( ops != nullptr )
+            {
+                ops->move( storage, other.storage );
+                other.ops = nullptr;
+            }
+        }
+
+        Callback &operator=( const Callback &other )
+        {
+            if( this != &other )
+            {
+                Callback copied( other );
+                *this = std::move( copied );
+            }
+            return *this;
+        }
+
+        Callback &operator=( Callback &&other ) noexcept
+        {
+            if( this != &other )
+            {
+                reset( );
+                if( other.ops != nullptr )
+                {
+                    other.ops->move( storage, other.storage );
+                    ops       = other.ops;
+                    other.ops = nullptr;
+                }
+            }
+            return *this;
         }
 
-        Callback( Callback && )                   = default;
-        Callback &operator=( Callback && )        = default;
-        Callback( const Callback & )              = default;
-        Callback   &operator=( const Callback   &) = default;
+        ~Callback( ) { reset( ); }
 
+        // Run the callback for a single event on channel input
         void        operator( )( int input ) const;
 
+        // Run the callback for a batch of events
+        void        operator( )( const EdgeEventSpan &events ) const;
+
         friend bool operator==( const Callback &A, const Callback &B );
         friend bool operator!=( const Callback &A, const Callback &B );
 
       private:
-        func_t                                                function;
-        std::function<bool( const func_t &, const func_t & )> comparer;
+        void reset( ) noexcept
+        {
+            if( ops != nullptr )
+            {
+                ops->destroy( storage );
+                ops = nullptr;
+            }
+        }
+
+      private:
+        mutable storage_t storage;
+        const Ops        *ops{ nullptr };
     };
 
     //--------------EVENTS--------------------------------
@@ -246,7 +600,8 @@ namespace GPIO
 
     /*
     Function used to add a callback function to channel, after it has been
-    registered for events using add_event_detect()
+    registered for events using add_event_detect().
+    See GPIO::Callback for the accepted callback signatures.
     */
 
     void add_event_callback( const std::string &channel,
@@ -254,11 +609,28 @@ namespace GPIO
     void add_event_callback( int channel, const Callback &callback );
 
     /* Function used to remove a callback function previously added to detect a
-     * channel event */
+     * channel event. Events being dispatched may still run it once. */
     void remove_event_callback( const std::string &channel,
                                 const Callback    &callback );
     void remove_event_callback( int channel, const Callback &callback );
 
+    /*
+    Edge event buffers of a line, given to add_event_detect().
+    kernel_events is the number of events the kernel queues for the line
+    request of the channel before dropping the oldest ones, 0 for its
+    default of 16 per line of the request, at most 1024. The kernel only
+    sets it when lines are requested, so asking for a bigger buffer than the
+    line request has requests its lines again: outputs sharing the request
+    keep their value, and other threads using these lines wait meanwhile.
+    read_events is the number of events the event thread reads from the
+    line in one go, they are passed to the callbacks as one batch.
+    */
+    struct EventBuffers
+    {
+        size_t kernel_events{ 0 };
+        size_t read_events{ 64 };
+    };
+
     /*
     Function used to add threaded event detection for a specified gpio channel.
     @gpio must be an integer specifying the channel
@@ -267,14 +639,26 @@ namespace GPIO
     is detected (or nullptr)
     @bouncetime (optional) a button-bounce signal ignore time (in milliseconds,
     default=none)
+    @buffers (optional) sizes of the edge event buffers of the line
     */
 
     void add_event_detect( const std::string &channel, Edge edge,
                            const Callback &callback    = nullptr,
-                           unsigned long   bounce_time = 0 );
+                           unsigned long   bounce_time = 0,
+                           const EventBuffers &buffers = EventBuffers( ) );
     void add_event_detect( int channel, Edge edge,
                            const Callback &callback    = nullptr,
-                           unsigned long   bounce_time = 0 );
+                           unsigned long   bounce_time = 0,
+                           const EventBuffers &buffers = EventBuffers( ) );
+
+    /*
+    Number of edge events of channel dropped by the kernel since
+    add_event_detect(), because its buffer was full when the event thread
+    read it. They are counted from the gaps in the line sequence numbers,
+    whether or not their edge is the one detected.
+    */
+    unsigned long events_dropped( const std::string &channel );
+    unsigned long events_dropped( int channel );
 
     /* Function used to remove event detection for channel */
     void remove_event_detect( const std::string &channel );
@@ -282,13 +666,14 @@ namespace GPIO
 
     /*
     Function used to perform a blocking wait until the specified edge event is
-    detected within the specified timeout period. Returns the channel if an
-    event is detected or 0 if a timeout has occurred.
+    detected within the specified timeout period. Returns 1 if an event is
+    detected or 0 if a timeout has occurred. wait_for_edges() gives the
+    channel of each event.
     @channel is an integer specifying the channel
     @edge must be a member of GPIO::Edge
     @bouncetime in milliseconds (optional)
     @timeout in milliseconds (optional)
-    @returns channel for an event, 0 for a timeout
+    @returns 1 for an event, 0 for a timeout
     */
 
     int wait_for_edge( const std::string &channel, Edge edge,
@@ -296,10 +681,157 @@ namespace GPIO
     int wait_for_edge( int channel, Edge edge, unsigned long bounce_time = 0,
                        int64_t timeout = -1 );
 
+    /*
+    Blocking wait for the edge on any of channels. The line requests of the
+    channels are polled together, with no lock held, so other threads keep
+    using the library meanwhile. Returns the events read once an edge is
+    detected, oldest first, with their channel set, or none on a timeout.
+    The channels must not be detecting events, or share their line request
+    with a channel that is, nor be waited on by another thread.
+    The channels keep detecting the edge once it returns, so a loop calling
+    it gets the edges occurring between two calls too.
+    @bouncetime in milliseconds (optional)
+    @timeout in milliseconds, -1 to wait forever (optional)
+    */
+    template <typename T>
+    std::vector<EdgeEvent>
+    wait_for_edges( const std::initializer_list<T> &channels, Edge edge,
+                    unsigned long bounce_time = 0, int64_t timeout = -1 );
+    template <typename T>
+    std::vector<EdgeEvent>
+    wait_for_edges( const std::vector<T> &channels, Edge edge,
+                    unsigned long bounce_time = 0, int64_t timeout = -1 );
+
+    /*
+    Same as above, giving the events in events instead. A loop passing the
+    same vector doesn't allocate once it has held the largest batch of
+    events.
+    */
+    template <typename T>
+    void wait_for_edges( const std::vector<T> &channels, Edge edge,
+                         std::vector<EdgeEvent> &events,
+                         unsigned long bounce_time = 0, int64_t timeout = -1 );
+
+    /*
+    Mirrored inputs. The event thread keeps the level of a mirrored input up
+    to date from the edge events of the line, so input() and Line::read()
+    return it without a system call. Mirroring enables the detection of both
+    edges on the line, callbacks and event_detected() still only get the
+    edge given to add_event_detect(). wait_for_edge() can't be used on a
+    mirrored input.
+    The mirror stops when the channel is set up as an output or cleaned up.
+    A status is stale while its value may lag the pin: the mirror is stopped,
+    or edges of the line request are still waiting for the event thread.
+    */
+    struct InputMirrorStatus
+    {
+        int           value;        // level returned by input()
+        uint64_t      timestamp_ns; // of the edge or initial read giving it
+        unsigned long line_seqno;   // of the edge giving it, 0 if none yet
+        bool          stale;        // stopped, or edges not applied yet
+        bool          overflowed;   // edges were lost since the last call
+    };
+
+    void              mirror_input( const std::string &channel,
+                                    bool               enable = true );
+    void              mirror_input( int channel, bool enable = true );
+
+    InputMirrorStatus input_mirror_status( const std::string &channel );
+    InputMirrorStatus input_mirror_status( int channel );
+
     // event cleanup
     void event_cleanup( unsigned int channel );
 
+    //--------------NOEXCEPT API-------------------------------
+
+    /*
+    Same as the functions above, returning a Status instead of printing
+    errors and terminating the process. The functions above are wrappers
+    around these, reporting errors as they always did.
+    */
+    Result<Line> try_setup( const std::string &channel, Directions direction,
+                            int initial = -1 ) noexcept;
+    Result<Line> try_setup( int channel, Directions direction,
+                            int initial = -1 ) noexcept;
+
+    Result<int>  try_input( const std::string &channel ) noexcept;
+    Result<int>  try_input( int channel ) noexcept;
+
+    Status       try_output( const std::string &channel, int value,
+                             bool force = false ) noexcept;
+    Status       try_output( int channel, int value,
+                             bool force = false ) noexcept;
+
+    Status       try_toggle( const std::string &channel ) noexcept;
+    Status       try_toggle( int channel ) noexcept;
+
+    Result<int>  try_event_detected( const std::string &channel ) noexcept;
+    Result<int>  try_event_detected( int channel ) noexcept;
+
+    Status       try_add_event_callback( const std::string &channel,
+                                         const Callback    &callback ) noexcept;
+    Status       try_add_event_callback( int             channel,
+                                         const Callback &callback ) noexcept;
+
+    Status try_remove_event_callback( const std::string &channel,
+                                      const Callback    &callback ) noexcept;
+    Status try_remove_event_callback( int             channel,
+                                      const Callback &callback ) noexcept;
+
+    Status try_add_event_detect(
+        const std::string &channel, Edge edge,
+        const Callback &callback = nullptr, unsigned long bounce_time = 0,
+        const EventBuffers &buffers = EventBuffers( ) ) noexcept;
+    Status try_add_event_detect(
+        int channel, Edge edge, const Callback &callback = nullptr,
+        unsigned long       bounce_time = 0,
+        const EventBuffers &buffers     = EventBuffers( ) ) noexcept;
+
+    Result<unsigned long>
+    try_events_dropped( const std::string &channel ) noexcept;
+    Result<unsigned long> try_events_dropped( int channel ) noexcept;
+
+    Status try_remove_event_detect( const std::string &channel ) noexcept;
+    Status try_remove_event_detect( int channel ) noexcept;
+
     //--------------PWM---------------------------------------
+
+    /*
+    Scheduling of the software PWM thread.
+    priority > 0 runs the thread with the SCHED_FIFO real time policy at
+    that priority (needs CAP_SYS_NICE), 0 keeps the default policy.
+    cpu >= 0 pins the thread to that CPU, -1 lets it run on any CPU.
+    */
+    struct PwmThreadOptions
+    {
+        int priority{ 0 };
+        int cpu{ -1 };
+    };
+
+    /*
+    Function used to set the scheduling of software PWM threads.
+    Applies to software PWM channels started afterwards.
+    */
+    void set_pwm_thread_options( const PwmThreadOptions &options );
+
+    /*
+    Timing of a software PWM channel as measured by its thread, from the
+    times the line was actually written. Errors are the difference from the
+    configured period and high time. Hardware PWM channels report no periods.
+    */
+    struct PwmStats
+    {
+        uint64_t periods{ 0 };           // measured periods
+        uint64_t overruns{ 0 };          // deadlines missed by a full period
+        double   period_mean_ns{ 0.0 };  // mean period
+        double   period_stddev_ns{ 0.0 };
+        uint64_t period_max_error_ns{ 0 };
+        double   high_mean_ns{ 0.0 };    // mean high time
+        double   high_stddev_ns{ 0.0 };
+        uint64_t high_max_error_ns{ 0 };
+        uint64_t wakeup_max_late_ns{ 0 }; // worst wake up after a deadline
+    };
+
     class GpioPwmIf;
     class PWM
     {
@@ -316,6 +848,10 @@ namespace GPIO
         void ChangeFrequency( int frequency_hz );
         void ChangeDutyCycle( double duty_cycle_percent );
 
+        // Timing measured since start() or the last ResetStats()
+        PwmStats GetStats( ) const;
+        void     ResetStats( );
+
       private:
         GpioPwmIf *pImpl{ nullptr };
     };
@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef _GPIO_SIM_H
+#define _GPIO_SIM_H
+
+// standard headers
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+Control of the simulated GPIO backend, selected by running the program with
+TI_GPIO_BACKEND=sim. The board model is injected with TI_GPIO_SIM_MODEL
+(J721E_SK by default), since it is resolved before main() runs.
+Channels are given in the numbering mode set with GPIO::setmode(). Calling
+these functions with another backend in use is an error.
+*/
+namespace GPIO
+{
+    namespace sim
+    {
+        // One level of an input waveform, held for hold_ns
+        struct WaveformStep
+        {
+            int      value;
+            uint64_t hold_ns;
+        };
+
+        // A value written to an output line
+        struct OutputSample
+        {
+            uint64_t timestamp_ns; // CLOCK_MONOTONIC, as edge events
+            int      value;
+        };
+
+        /*
+        Time spent in each kind of backend call, to model the cost of the
+        kernel. The simulated call busy waits for it.
+        */
+        struct Latency
+        {
+            uint64_t request_ns{ 0 };     // requesting and reconfiguring lines
+            uint64_t get_ns{ 0 };         // reading a value
+            uint64_t set_ns{ 0 };         // writing one or more values
+            uint64_t read_events_ns{ 0 }; // reading edge events
+        };
+
+        // Whether the simulated backend is in use
+        bool                      enabled( );
+
+        // Drive the level seen by an input channel now
+        void                      set_input( const std::string &channel,
+                                             int                value );
+        void                      set_input( int channel, int value );
+
+        /*
+        Play a waveform on an input channel from a background thread, the
+        first step starting now. A waveform already playing on the channel
+        is replaced. With repeat, the steps are played until stop().
+        */
+        void play( const std::string               &channel,
+                   const std::vector<WaveformStep> &steps,
+                   bool                             repeat = false );
+        void play( int channel, const std::vector<WaveformStep> &steps,
+                   bool repeat = false );
+
+        // Stop the waveform of a channel, keeping its current level
+        void                      stop( const std::string &channel );
+        void                      stop( int channel );
+
+        // Wait until every waveform not repeating is played
+        void                      wait_waveforms( );
+
+        /*
+        Record the values written to an output channel, dropping what was
+        recorded before. capacity samples are reserved, so writes don't
+        allocate until that many are recorded.
+        */
+        void                      record( const std::string &channel,
+                                          size_t             capacity = 0 );
+        void                      record( int channel, size_t capacity = 0 );
+
+        // Values written to the channel since record()
+        std::vector<OutputSample> recorded( const std::string &channel );
+        std::vector<OutputSample> recorded( int channel );
+
+        void                      set_latency( const Latency &latency );
+
+    } // namespace sim
+
+} // namespace GPIO
+
+#endif // _GPIO_SIM_H
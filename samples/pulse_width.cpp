@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+// Standard headers
+#include <cstdint>
+#include <iostream>
+// for delay function.
+#include <chrono>
+#include <thread>
+
+// for signal handling
+#include <signal.h>
+
+// Interface headers
+#include <GPIO.h>
+
+using namespace std;
+
+// Pin Definitions
+const int   input_pin        = 18; // BOARD pin 18
+
+static bool end_this_program = false;
+
+void signalHandler( int s )
+{
+    end_this_program = true;
+}
+
+/*
+Measures the width of the high pulses on input_pin using the kernel
+timestamps of the edge events, so the numbers don't depend on how quickly
+the event thread gets scheduled.
+*/
+class PulseMeter
+{
+  public:
+    explicit PulseMeter( int channel ) : channel( channel ) {}
+
+    void operator( )( const GPIO::EdgeEventSpan &events )
+    {
+        for( const GPIO::EdgeEvent &event : events )
+        {
+            if( event.edge == GPIO::RISING )
+            {
+                rise_ns = event.timestamp_ns;
+            }
+            else if( rise_ns != 0 )
+            {
+                cout << "pulse #" << event.line_seqno << ": "
+                     << ( event.timestamp_ns - rise_ns ) / 1000 << " us"
+                     << endl;
+                rise_ns = 0;
+            }
+        }
+    }
+
+    bool operator==( const PulseMeter &other ) const
+    {
+        return channel == other.channel;
+    }
+
+  private:
+    int      channel;
+    uint64_t rise_ns{ 0 };
+};
+
+int main( )
+{
+    // When CTRL+C pressed, signalHandler will be called
+    signal( SIGINT, signalHandler );
+
+    // Pin Setup.
+    GPIO::setmode( GPIO::BOARD );
+    GPIO::setup( input_pin, GPIO::IN );
+
+    cout << "Measuring pulses on pin " << input_pin
+         << ". Press CTRL+C to exit" << endl;
+
+    GPIO::add_event_detect( input_pin, GPIO::BOTH, PulseMeter( input_pin ) );
+
+    while( !end_this_program )
+    {
+        this_thread::sleep_for( chrono::milliseconds( 100 ) );
+    }
+
+    GPIO::cleanup( );
+
+    return 0;
+}
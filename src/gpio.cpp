@@ -26,12 +26,15 @@ DEALINGS IN THE SOFTWARE.
 
 // Standard headers
 #include <dirent.h>
+#include <poll.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <atomic>
 #include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -40,6 +43,7 @@ DEALINGS IN THE SOFTWARE.
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -48,8 +52,11 @@ DEALINGS IN THE SOFTWARE.
 #include <GPIO.h>
 
 // Local headers
+#include "gpio_backend.h"
 #include "gpio_common.h"
+#include "gpio_event_engine.h"
 #include "gpio_hw_pwm.h"
+#include "gpio_line.h"
 #include "gpio_pin_data.h"
 #include "gpio_sw_pwm.h"
 #include "model.h"
@@ -57,6 +64,9 @@ DEALINGS IN THE SOFTWARE.
 
 #define MAX_EVENTS 64
 
+// Largest kernel edge event buffer of a line request
+#define MAX_EVENT_BUFFER_SIZE 1024
+
 using namespace GPIO;
 using namespace std;
 
@@ -64,28 +74,35 @@ namespace GPIO
 {
 
     //================================================================================
-    std::atomic_bool         _run_loop;
-    std::recursive_mutex     _epmutex;
-    auto                    &global = GlobalVariableWrapper::get_instance( );
-    std::thread             *event_handler  = nullptr;
-    std::atomic_bool         end_wait_event = false;
-
-    gpiod_chip              *chip           = NULL;
-    gpiod_line_info         *line_info      = NULL;
-    gpiod_line_direction     gpio_direction = GPIOD_LINE_DIRECTION_AS_IS;
-    gpiod_line_config       *line_config    = NULL;
-    gpiod_line_request      *line_req       = NULL;
-    gpiod_line_settings     *line_settings  = NULL;
-    gpiod_edge_event_buffer *event_buffer   = NULL;
-
-    std::set<gpiod_chip *>   chips_open;
-
-    std::map<const int, gpiod_line_info *>         channelLineInfo;
-    std::map<const int, gpiod_line_config *>       channelLineConfig;
-    std::map<const int, gpiod_line_settings *>     channelLineSettings;
-    std::map<const int, gpiod_line_request *>      channelLineRequest;
-    std::map<const int, gpiod_edge_event_buffer *> channelEventBuffer;
-    std::map<const int, vector<Callback>>          event_callbacks;
+    auto &global = GlobalVariableWrapper::get_instance( );
+
+    using LineStates = std::map<std::pair<int, unsigned int>, LineState>;
+
+    // Keyed by gpiochip, the lock shared by its LineStates
+    std::map<int, std::recursive_mutex> chip_locks;
+
+    /*
+    A LineState for every GPIO line of the board. The map is not modified
+    after this, so it is read without a lock.
+    */
+    static LineStates _make_line_states( )
+    {
+        LineStates           states{ };
+        const PinDefinition *pin_defs = global._pinData.pin_defs;
+
+        for( size_t i = 0; i < global._pinData.pin_count; i++ )
+        {
+            const PinDefinition &x = pin_defs[i];
+            states.try_emplace( std::make_pair( x.gpiochip, x.LinuxPin ),
+                                x.gpiochip, x.LinuxPin,
+                                chip_locks[x.gpiochip] );
+        }
+
+        return states;
+    }
+
+    // Keyed by (gpiochip, offset). std::map keeps element addresses stable.
+    LineStates line_states = _make_line_states( );
     //================================================================================
 
     void _validate_mode_set( )
@@ -99,81 +116,201 @@ namespace GPIO
         }
     }
 
-    ChannelInfo _channel_to_info_lookup( const string &channel, bool need_gpio,
-                                         bool need_pwm )
+    const ChannelInfo &_channel_to_info_lookup( const string &channel,
+                                                bool need_gpio, bool need_pwm )
     {
-        if( !is_in( channel, global._channel_data ) )
+        const auto &channel_data = *global._channel_data.load( );
+        auto        it           = channel_data.find( channel );
+        if( it == channel_data.end( ) )
         {
             throw runtime_error( "Channel " + channel + " is invalid" );
         }
 
-        ChannelInfo ch_info = global._channel_data.at( channel );
-        return ch_info;
+        return it->second;
     }
 
-    ChannelInfo _channel_to_info( const string &channel, bool need_gpio = false,
-                                  bool need_pwm = false )
+    const ChannelInfo &_channel_to_info( const string &channel, bool need_gpio,
+                                         bool need_pwm )
     {
         _validate_mode_set( );
         return _channel_to_info_lookup( channel, need_gpio, need_pwm );
     }
 
-    // Cleanup gpiod configurations
-    void _cleanup_gpiod( )
+    LineState &_line_state( const ChannelInfo &ch_info )
+    {
+        auto key = std::make_pair( ch_info.chip_gpio, ch_info.gpio );
+        return line_states.find( key )->second;
+    }
+
+    void _enter_lines( const vector<LineState *> &states,
+                       vector<LineUse>           &uses )
+    {
+        for( ;; )
+        {
+            uses.clear( );
+
+            LineState *held = nullptr;
+            for( LineState *state : states )
+            {
+                uses.emplace_back( );
+                if( !uses.back( ).enter( *state ) )
+                {
+                    held = state;
+                    break;
+                }
+            }
+
+            if( held == nullptr )
+            {
+                return;
+            }
+
+            uses.clear( );
+            LineUse::wait( *held );
+        }
+    }
+
+    const char *status_string( Status status ) noexcept
+    {
+        switch( status )
+        {
+            case Status::OK:
+                return "Success";
+            case Status::MODE_NOT_SET:
+                return "Please set pin numbering mode using "
+                       "GPIO::setmode(GPIO::BOARD), GPIO::setmode(GPIO::BCM), "
+                       "or GPIO::setmode(GPIO::SOC)";
+            case Status::INVALID_CHANNEL:
+                return "The channel is invalid";
+            case Status::NOT_SET_UP:
+                return "You must setup() the GPIO channel first";
+            case Status::NOT_INPUT:
+                return "You must setup() the GPIO channel as an input first";
+            case Status::NOT_OUTPUT:
+                return "The GPIO channel has not been set up as an OUTPUT";
+            case Status::NOT_DETECTING:
+                return "The edge event must have been set via "
+                       "add_event_detect()";
+            case Status::PWM_IN_USE:
+                return "The channel is already running as PWM";
+            case Status::NOT_GPIO:
+                return "The channel is a hardware PWM pin, use GPIO::PWM";
+            case Status::NOT_FOUND:
+                return "Callback not found";
+            case Status::INVALID_ARGUMENT:
+                return "Invalid argument";
+            case Status::BUSY:
+                return "The GPIO line is busy";
+            case Status::INTERRUPTED:
+                return "Interrupted system call";
+            case Status::NO_MEMORY:
+                return "Out of memory";
+            case Status::IO_ERROR:
+                break;
+        }
+        return "GPIO driver error";
+    }
+
+    // Status of a failed backend call, from its errno
+    static Status _errno_status( int error ) noexcept
+    {
+        switch( error )
+        {
+            case EBUSY:
+            case EAGAIN:
+                return Status::BUSY;
+            case EINTR:
+                return Status::INTERRUPTED;
+            case ENOMEM:
+                return Status::NO_MEMORY;
+            default:
+                return Status::IO_ERROR;
+        }
+    }
+
+    // Status of an exception thrown while serving a try_ function
+    static Status _exception_status( ) noexcept
+    {
+        try
+        {
+            throw;
+        }
+        catch( const system_error &e )
+        {
+            return _errno_status( e.code( ).value( ) );
+        }
+        catch( const bad_alloc & )
+        {
+            return Status::NO_MEMORY;
+        }
+        catch( const invalid_argument & )
+        {
+            return Status::INVALID_ARGUMENT;
+        }
+        catch( ... )
+        {
+            return Status::IO_ERROR;
+        }
+    }
+
+    // _channel_to_info() returning a Status instead of throwing
+    static const ChannelInfo *_find_channel( const string &channel,
+                                             Status       &status ) noexcept
     {
-        if( event_buffer != NULL )
+        if( global._gpio_mode == NumberingModes::None )
         {
-            gpiod_edge_event_buffer_free( event_buffer );
+            status = Status::MODE_NOT_SET;
+            return nullptr;
         }
 
-        gpiod_line_settings_free( line_settings );
-        gpiod_line_config_free( line_config );
-        gpiod_line_info_free( line_info );
-        gpiod_chip_close( chip );
+        const auto &channel_data = *global._channel_data.load( );
+        auto        it           = channel_data.find( channel );
+        if( it == channel_data.end( ) )
+        {
+            status = Status::INVALID_CHANNEL;
+            return nullptr;
+        }
+
+        return &it->second;
+    }
+
+    // Whether the status comes from the GPIO backend rather than the caller
+    static bool _is_driver_error( Status status ) noexcept
+    {
+        return status == Status::BUSY || status == Status::INTERRUPTED ||
+               status == Status::NO_MEMORY || status == Status::IO_ERROR;
+    }
+
+    // Report a status the way the functions not returning it always did
+    static void _print_status( Status status, const char *caller )
+    {
+        cerr << "[Exception] " << status_string( status )
+             << " (caught from: " << caller << ")" << endl;
     }
 
     /*
-    Return the current configuration of a channel as reported by gpiod.
+    Return the current configuration of a channel as reported by the
+    GPIO backend.
     Any of IN, OUT, HARD_PWM, or UNKNOWN may be returned.
     */
 
     Directions _channel_configuration( const ChannelInfo &ch_info )
     {
-        if( !is_None( ch_info.pwm_chip_dir ) )
+        const string &pwm_chip_dir = ch_info.pwm_chip_dir( );
+        if( !is_None( pwm_chip_dir ) )
         {
             string pwm_dir =
-                ch_info.pwm_chip_dir + "/pwm" + to_string( ch_info.pwm_id );
+                pwm_chip_dir + "/pwm" + to_string( ch_info.pwm_id );
             if( os_path_exists( pwm_dir ) )
             {
                 return HARD_PWM;
             }
-        }
-        else
-        {
-            if( chip != NULL )
-            {
-                line_info = gpiod_chip_get_line_info( chip, ch_info.gpio );
-                if( line_info != NULL )
-                {
-                    channelLineInfo[ch_info.gpio] = line_info;
-                    gpio_direction = gpiod_line_info_get_direction( line_info );
-                }
-            }
-        }
 
-        if( gpio_direction == GPIOD_LINE_DIRECTION_INPUT )
-        {
-            return IN;
-        }
-        else if( gpio_direction == GPIOD_LINE_DIRECTION_OUTPUT )
-        {
-            return OUT;
-        }
-        else
-        {
             return UNKNOWN; // Originally returns None in TI's GPIO Python
                             // Library
         }
+
+        return _backend( ).line_direction( ch_info.chip_gpio, ch_info.gpio );
     }
 
     /*
@@ -183,6 +320,8 @@ namespace GPIO
 
     Directions _app_channel_configuration( const ChannelInfo &ch_info )
     {
+        lock_guard<mutex> lock( global._config_lock );
+
         if( !is_in( ch_info.channel, global._channel_configuration ) )
         {
             return UNKNOWN; // Originally returns None in TI's GPIO Python
@@ -191,209 +330,401 @@ namespace GPIO
         return global._channel_configuration[ch_info.channel];
     }
 
-    int _reconfigure_lines( struct gpiod_line_request *request,
-                            ChannelInfo ch_info, Directions direction,
-                            int value )
+    void _set_app_channel_configuration( const string &channel,
+                                         Directions    direction )
+    {
+        lock_guard<mutex> lock( global._config_lock );
+        global._channel_configuration[channel] = direction;
+    }
+
+    bool _is_pwm_channel( const string &channel )
+    {
+        lock_guard<mutex> lock( global._config_lock );
+        return is_in( channel, global._pwm_channels );
+    }
+
+    /*
+    Apply the configuration of the line to its line request. The whole request
+    is reconfigured at once, so the other output lines of the request are
+    given the value they drive, as last written by their users. The lines are
+    held meanwhile, so no write lands between reading that value and the
+    reconfiguration.
+    Called with the chip lock of the line held, as are the functions below
+    changing the line requests.
+    */
+    int _apply_line_settings( LineState &state )
     {
-        struct gpiod_line_settings *settings;
-        struct gpiod_line_config   *line_cfg;
-        int                         ret = -1;
+        LineRequest       &line_request = *state.line_request;
+        HeldLines          held( line_request.lines );
+        vector<LineConfig> configs{ };
 
-        settings                        = gpiod_line_settings_new( );
-        if( !settings )
+        for( LineState *line : line_request.lines )
         {
-            return -1;
+            if( line != &state && line->direction == OUT )
+            {
+                // Only unknown after a failed write
+                int value = line->driven.load( memory_order_relaxed );
+                if( value == -1 )
+                {
+                    value = line_request.request->get_value( line->offset );
+                    if( value == -1 )
+                    {
+                        return -1;
+                    }
+                    line->driven = value;
+                }
+                line->config.value = value;
+            }
+
+            configs.push_back( line->config );
         }
 
+        return line_request.request->reconfigure( configs );
+    }
+
+    int _reconfigure_lines( LineState &state, Directions direction, int value )
+    {
+        // Users see the new direction and the new configuration together
+        HeldLines held( state );
+
         if( direction == OUT )
         {
-            gpiod_line_settings_set_direction( settings,
-                                               GPIOD_LINE_DIRECTION_OUTPUT );
+            EventEngine::get_instance( ).unwatch( state );
+
+            state.config.direction = OUT;
+            state.config.edge      = Edge::NONE;
+            state.user_edge        = Edge::NONE;
+            state.config.value     = value == 1 ? HIGH : LOW;
         }
         else
         {
-            gpiod_line_settings_set_direction( settings,
-                                               GPIOD_LINE_DIRECTION_INPUT );
+            state.config.direction = IN;
         }
 
-        if( direction == OUT )
+        int ret = _apply_line_settings( state );
+
+        state.driven = ret == 0 && direction == OUT ? state.config.value : -1;
+        if( ret == 0 )
         {
-            gpiod_line_value val;
+            state.direction = direction;
+            _set_app_channel_configuration( state.channel, direction );
+        }
 
-            if( value == 1 )
-            {
-                val = GPIOD_LINE_VALUE_ACTIVE;
-            }
-            else
-            {
-                val = GPIOD_LINE_VALUE_INACTIVE;
-            }
+        return ret;
+    }
 
-            gpiod_line_settings_set_output_value( settings, val );
+    // Size the read buffer of the request for the events of all its lines
+    static void _size_request_events( LineRequest &line_request )
+    {
+        size_t size = 0;
+        for( LineState *line : line_request.lines )
+        {
+            size += line->events.size( );
         }
 
-        line_cfg = gpiod_line_config_new( );
-        if( !line_cfg )
+        line_request.events.resize( size );
+    }
+
+    /*
+    Request the lines of states, as configured, with a single line request
+    and attach them to it. Their direction is left to the caller to publish.
+    */
+    static void _attach_request( int                        chip_gpio,
+                                 const vector<LineState *> &states,
+                                 size_t                     event_buffer_size )
+    {
+        vector<LineConfig> configs{ };
+        for( LineState *state : states )
         {
-            goto free_settings;
+            configs.push_back( state->config );
         }
 
-        ret = gpiod_line_config_add_line_settings( line_cfg, &ch_info.gpio, 1,
-                                                   settings );
-        if( ret )
+        auto line_request = make_shared<LineRequest>(
+            _backend( ).request_lines( chip_gpio, configs, event_buffer_size ),
+            event_buffer_size );
+
+        for( LineState *state : states )
         {
-            goto free_line_config;
+            state->line_request = line_request;
+            state->request      = line_request->request.get( );
+            state->last_seqno   = 0; // restarts with the request
+            line_request->lines.push_back( state );
         }
 
-        ret = gpiod_line_request_reconfigure_lines( request, line_cfg );
-
-        global._channel_configuration[ch_info.channel] = direction;
+        _size_request_events( *line_request );
+    }
 
-    free_line_config:
-        gpiod_line_config_free( line_cfg );
+    // Line requests of gpiochip chip_gpio held by this process
+    static vector<shared_ptr<LineRequest>> _chip_requests( int chip_gpio )
+    {
+        vector<shared_ptr<LineRequest>> requests{ };
 
-    free_settings:
-        gpiod_line_settings_free( settings );
+        for( auto it = line_states.lower_bound( { chip_gpio, 0 } );
+             it != line_states.end( ) && it->first.first == chip_gpio; ++it )
+        {
+            const auto &line_request = it->second.line_request;
+            if( line_request != nullptr &&
+                std::find( requests.begin( ), requests.end( ),
+                           line_request ) == requests.end( ) )
+            {
+                requests.push_back( line_request );
+            }
+        }
 
-        return ret;
+        return requests;
     }
-    void _setup_single_out( const ChannelInfo &ch_info, int initial )
+
+    /*
+    Kernel event buffer size for the merge of requests, 0 for the default.
+    The default of 16 events per line is kept for the merged lines, unless
+    one of the requests asked for more.
+    */
+    static size_t _merged_buffer_size( const vector<size_t> &sizes,
+                                       size_t                line_count )
     {
-        std::string gpiochipX =
-            "/dev/gpiochip" + to_string( ch_info.chip_gpio );
-        chip = gpiod_chip_open( gpiochipX.c_str( ) );
-        if( chip == NULL )
+        size_t largest = 0;
+        for( size_t size : sizes )
         {
-            throw runtime_error( "GPIO open chip failed\n" );
+            largest = max( largest, size );
         }
 
-        line_settings = gpiod_line_settings_new( );
+        if( largest == 0 )
+        {
+            return 0;
+        }
+        return min<size_t>( max<size_t>( largest, 16 * line_count ),
+                            MAX_EVENT_BUFFER_SIZE );
+    }
 
-        gpiod_line_value val;
+    /*
+    Replace the line requests previous of gpiochip chip_gpio with a single
+    request of all their lines and of the lines added, with a kernel buffer
+    of event_buffer_size edge events, as the kernel can neither add lines to
+    a request nor change its buffer size. The lines of previous keep their
+    configuration, outputs the value they drive, and the watched lines are
+    watched again. The lines of previous are held meanwhile, so the lock
+    free users wait for the new request rather than use the one released.
+    The lines added must be configured, their direction is left to the
+    caller to publish.
+    Throws system_error if the new request fails, previous are then
+    requested again as they were and the lines added stay unrequested.
+    */
+    static void
+    _replace_requests( int chip_gpio, vector<shared_ptr<LineRequest>> previous,
+                       const vector<LineState *> &added,
+                       size_t                     event_buffer_size )
+    {
+        vector<vector<LineState *>> groups{ };
+        vector<size_t>              sizes{ };
+        vector<LineState *>         states{ };
+        vector<Directions>          directions{ };
 
-        if( initial == 1 )
+        for( const auto &line_request : previous )
         {
-            val = GPIOD_LINE_VALUE_ACTIVE;
+            groups.push_back( line_request->lines );
+            sizes.push_back( line_request->event_buffer_size );
+            states.insert( states.end( ), line_request->lines.begin( ),
+                           line_request->lines.end( ) );
         }
-        else
+
+        // Until the lines are attached to a request again
+        HeldLines held( states );
+
+        for( LineState *line : states )
         {
-            val = GPIOD_LINE_VALUE_INACTIVE;
+            if( line->direction == OUT )
+            {
+                // Only unknown after a failed write
+                int value = line->driven.load( memory_order_relaxed );
+                if( value == -1 )
+                {
+                    value = line->request->get_value( line->offset );
+                    if( value == -1 )
+                    {
+                        throw system_error( errno, generic_category( ),
+                                            "failed to read the GPIO line" );
+                    }
+                    line->driven = value;
+                }
+                line->config.value = value;
+            }
+
+            directions.push_back( line->direction );
         }
 
-        int status = gpiod_line_settings_set_output_value( line_settings, val );
-        if( status == -1 )
+        EventEngine        &engine = EventEngine::get_instance( );
+        vector<LineState *> watched{ };
+        vector<LineState *> mirrored{ };
+        for( LineState *line : states )
         {
-            _cleanup_gpiod( );
-            throw runtime_error(
-                "failed to set the output value the given GPIO line\n" );
+            if( line->mirror.enabled )
+            {
+                mirrored.push_back( line );
+            }
+            else if( line->watched )
+            {
+                watched.push_back( line );
+            }
+            engine.unwatch( *line );
+
+            line->direction = UNKNOWN;
+            line->request   = nullptr;
+            line->line_request.reset( );
         }
+        previous.clear( ); // releases the lines
 
-        status = gpiod_line_settings_set_direction(
-            line_settings, GPIOD_LINE_DIRECTION_OUTPUT );
-        if( status == -1 )
+        vector<LineState *> merged = states;
+        merged.insert( merged.end( ), added.begin( ), added.end( ) );
+
+        exception_ptr error{ };
+        try
         {
-            _cleanup_gpiod( );
-            throw runtime_error(
-                "failed to set the direction for the given GPIO line\n" );
+            _attach_request( chip_gpio, merged, event_buffer_size );
         }
-
-        line_config = gpiod_line_config_new( );
-        if( line_config == NULL )
+        catch( const system_error & )
         {
-            throw runtime_error( "failed to get line config\n" );
+            error = current_exception( );
+            for( size_t i = 0; i < groups.size( ); i++ )
+            {
+                _attach_request( chip_gpio, groups[i], sizes[i] );
+            }
         }
 
-        status = gpiod_line_config_add_line_settings(
-            line_config, &ch_info.gpio, 1, line_settings );
-        if( status == -1 )
+        // Publishes the requests to the lock free readers of direction
+        for( size_t i = 0; i < states.size( ); i++ )
         {
-            _cleanup_gpiod( );
-            throw runtime_error( "failed to configure the GPIO line\n" );
+            states[i]->direction = directions[i];
         }
 
-        // channel in use reconfigure
-        if( channelLineRequest.find( ch_info.gpio ) !=
-            channelLineRequest.end( ) )
+        for( LineState *line : watched )
         {
-            gpiod_line_request_release( channelLineRequest[ch_info.gpio] );
-            channelLineRequest.erase( ch_info.gpio );
+            engine.watch( *line );
         }
-
-        line_req = gpiod_chip_request_lines( chip, NULL, line_config );
-
-        if( line_req == NULL )
+        for( LineState *line : mirrored )
         {
-            _cleanup_gpiod( );
-            throw runtime_error( "failed to get the requested GPIO line\n" );
+            engine.mirror( *line );
         }
 
-        channelLineConfig[ch_info.gpio]                = line_config;
-        channelLineRequest[ch_info.gpio]               = line_req;
-        channelLineSettings[ch_info.gpio]              = line_settings;
-
-        global._channel_configuration[ch_info.channel] = OUT;
-    }
-
-    void _setup_single_in( const ChannelInfo &ch_info )
-    {
-        std::string gpiochipX =
-            "/dev/gpiochip" + to_string( ch_info.chip_gpio );
-        chip = gpiod_chip_open( gpiochipX.c_str( ) );
-        if( chip == NULL )
+        if( error )
         {
-            throw runtime_error( "GPIO open chip failed\n" );
+            rethrow_exception( error );
         }
+    }
 
-        line_settings = gpiod_line_settings_new( );
+    /*
+    Request lines of gpiochip chip_gpio with a single line request, all with
+    the given direction and initial value. initial is only used for outputs.
+    Once merge_chip_requests() is enabled, the lines join the lines this
+    process already requested on the gpiochip in a single request instead.
+    */
+    void _request_lines( int                                chip_gpio,
+                         const vector<const ChannelInfo *> &channels,
+                         Directions direction, int initial )
+    {
+        vector<LineState *> states{ };
 
-        int status    = gpiod_line_settings_set_direction(
-            line_settings, GPIOD_LINE_DIRECTION_INPUT );
-        if( status == -1 )
+        for( const ChannelInfo *ch_info : channels )
         {
-            _cleanup_gpiod( );
-            throw runtime_error(
-                "failed to set the direction for the given GPIO line\n" );
+            LineState *state = &_line_state( *ch_info );
+            state->channel   = ch_info->channel;
+            states.push_back( state );
+
+            LineConfig config{ };
+            config.offset    = state->offset;
+            config.direction = direction;
+            config.value     = initial == 1 ? HIGH : LOW;
+            state->config    = config;
         }
 
-        line_config = gpiod_line_config_new( );
-        if( line_config == NULL )
+        // A request polled by wait_for_edges() can't be released, its
+        // lines keep it
+        vector<shared_ptr<LineRequest>> previous{ };
+        if( global._merge_chip_requests )
         {
-            throw runtime_error( "failed to get line config\n" );
+            for( auto &line_request : _chip_requests( chip_gpio ) )
+            {
+                if( line_request->waiter == nullptr )
+                {
+                    previous.push_back( std::move( line_request ) );
+                }
+            }
         }
 
-        status = gpiod_line_config_add_line_settings(
-            line_config, &ch_info.gpio, 1, line_settings );
-        if( status == -1 )
+        if( previous.empty( ) )
         {
-            _cleanup_gpiod( );
-            throw runtime_error( "failed to configure the GPIO line\n" );
+            _attach_request( chip_gpio, states, 0 );
         }
-
-        // channel in use reconfigure ?
-        if( channelLineRequest.find( ch_info.gpio ) !=
-            channelLineRequest.end( ) )
+        else
         {
-            gpiod_line_request_release( channelLineRequest[ch_info.gpio] );
-            channelLineRequest.erase( ch_info.gpio );
+            vector<size_t> sizes{ };
+            size_t         line_count = states.size( );
+            for( const auto &line_request : previous )
+            {
+                sizes.push_back( line_request->event_buffer_size );
+                line_count += line_request->lines.size( );
+            }
+
+            _replace_requests( chip_gpio, std::move( previous ), states,
+                               _merged_buffer_size( sizes, line_count ) );
         }
 
-        line_req = gpiod_chip_request_lines( chip, NULL, line_config );
-        if( line_req == NULL )
+        for( LineState *state : states )
         {
-            _cleanup_gpiod( );
-            throw runtime_error( "failed to get the requested GPIO line\n" );
+            state->driven    = direction == OUT ? state->config.value : -1;
+
+            // Publishes request to the lock free readers of direction
+            state->direction = direction;
+            _set_app_channel_configuration( state->channel, direction );
         }
+    }
+
+    // Request the lines of the line request of state again, see
+    // _replace_requests()
+    static void _request_again( LineState &state, size_t event_buffer_size )
+    {
+        // Moved in, the request must not outlive the call
+        vector<shared_ptr<LineRequest>> previous{ };
+        previous.push_back( state.line_request );
+        _replace_requests( state.chip_gpio, std::move( previous ), { },
+                           event_buffer_size );
+    }
+
+    void _setup_single_out( const ChannelInfo &ch_info, int initial )
+    {
+        _request_lines( ch_info.chip_gpio, { &ch_info }, OUT, initial );
+    }
+
+    void _setup_single_in( const ChannelInfo &ch_info )
+    {
+        _request_lines( ch_info.chip_gpio, { &ch_info }, IN, -1 );
+    }
+
+    /*
+    Publish a new callback list of the line, called with
+    state.callbacks_lock held. Event dispatch may still be running the
+    previous list, which is freed once it is done.
+    */
+    static void _store_callbacks( LineState                      &state,
+                                  std::shared_ptr<const CallbackList> list )
+    {
+        std::atomic_store_explicit( &state.callbacks, std::move( list ),
+                                    memory_order_release );
+    }
 
-        channelLineConfig[ch_info.gpio]                = line_config;
-        channelLineRequest[ch_info.gpio]               = line_req;
-        channelLineSettings[ch_info.gpio]              = line_settings;
+    // Stop the event detection of the line and drop its callbacks
+    static void _cleanup_events( LineState &state )
+    {
+        lock_guard<recursive_mutex> lock( state.chip_lock );
+
+        EventEngine::get_instance( ).unwatch( state );
 
-        global._channel_configuration[ch_info.channel] = IN;
+        lock_guard<mutex> callbacks_lock( state.callbacks_lock );
+        _store_callbacks( state, nullptr );
     }
 
     void _cleanup_one( const ChannelInfo &ch_info )
     {
-        Directions app_cfg = global._channel_configuration[ch_info.channel];
+        Directions app_cfg = _app_channel_configuration( ch_info );
         if( app_cfg == HARD_PWM )
         {
             hw_disable_pwm( ch_info );
@@ -401,13 +732,17 @@ namespace GPIO
         }
         else
         {
-            event_cleanup( ch_info.gpio );
+            _cleanup_events( _line_state( ch_info ) );
         }
     }
 
     void _cleanup_all( )
     {
-        auto copied = global._channel_configuration;
+        map<string, Directions> copied{ };
+        {
+            lock_guard<mutex> lock( global._config_lock );
+            copied = global._channel_configuration;
+        }
 
         for( const auto &_pair : copied )
         {
@@ -416,6 +751,9 @@ namespace GPIO
             _cleanup_one( ch_info );
         }
 
+        EventEngine::get_instance( ).stop( );
+        _backend( ).close_chips( );
+
         global._gpio_mode = NumberingModes::None;
     }
 
@@ -441,6 +779,11 @@ namespace GPIO
         global._gpio_warnings = state;
     }
 
+    void merge_chip_requests( bool enable )
+    {
+        global._merge_chip_requests = enable;
+    }
+
     // Function used to set the pin mumbering mode.
     // Possible mode values are BOARD, BCM, and SOC
     void setmode( NumberingModes mode )
@@ -454,8 +797,28 @@ namespace GPIO
                                      "GPIO::BCM, or GPIO::SOC" );
             }
 
-            global._channel_data = global._channel_data_by_mode.at( mode );
-            global._gpio_mode    = mode;
+            // Channels are looked up without a lock, the lookup table of
+            // the mode is published before the mode itself
+            if( global._gpio_mode == mode )
+            {
+                return;
+            }
+
+            {
+                // Only the tables of the modes in use are built
+                lock_guard<mutex> lock( global._channel_data_lock );
+                auto &tables = global._channel_data_by_mode;
+                auto  table  = tables.find( mode );
+                if( table == tables.end( ) )
+                {
+                    table = tables
+                                .emplace( mode, get_channel_data(
+                                                    global._pinData, mode ) )
+                                .first;
+                }
+                global._channel_data = &table->second;
+            }
+            global._gpio_mode = mode;
         }
 
         catch( exception &e )
@@ -478,86 +841,210 @@ namespace GPIO
     HIGH or LOW and is only valid when direction is OUT
     */
 
-    void setup( const string &channel, Directions direction, int initial )
+    Result<Line> try_setup( const string &channel, Directions direction,
+                            int initial ) noexcept
     {
-        try
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
         {
-            if( global._pwm_channels.find( channel ) !=
-                global._pwm_channels.end( ) )
-            {
-                throw runtime_error( "Channel " + channel +
-                                     " already running as PWM." );
-            }
+            return { status, Line( ) };
         }
 
-        catch( exception &e )
+        if( direction != OUT && direction != IN )
         {
-            cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::setup())" << endl;
-            _cleanup_all( );
-            terminate( );
+            return { Status::INVALID_ARGUMENT, Line( ) };
         }
 
         try
         {
-            ChannelInfo ch_info   = _channel_to_info( channel, true );
+            if( _is_pwm_channel( channel ) )
+            {
+                return { Status::PWM_IN_USE, Line( ) };
+            }
 
-            Directions  app_cfg   = _app_channel_configuration( ch_info );
-            Directions  gpiod_cfg = _channel_configuration( ch_info );
+            LineState                  &state = _line_state( *ch_info );
+            lock_guard<recursive_mutex> lock( state.chip_lock );
 
-            if( global._gpio_warnings )
+            // A line already requested by this process is reconfigured in
+            // place, it may share its line request with other lines
+            if( state.request != NULL )
             {
-                if( app_cfg != UNKNOWN && gpiod_cfg != UNKNOWN )
+                // initial is refused for inputs, as when the line is new
+                if( direction == IN && initial != -1 )
                 {
-                    cerr << "[WARNING] This channel is already in use, "
-                            "continuing anyway. "
-                            "Use GPIO::setwarnings(false) to "
-                            "disable warnings.\n";
+                    return { Status::INVALID_ARGUMENT, Line( ) };
                 }
-            }
 
-            if( app_cfg != UNKNOWN )
-            {
-                int status =
-                    _reconfigure_lines( channelLineRequest[ch_info.gpio],
-                                        ch_info, direction, initial );
-                if( status == -1 )
+                state.channel = ch_info->channel;
+
+                if( _reconfigure_lines( state, direction, initial ) == -1 )
                 {
-                    throw runtime_error( "Could not reconfigure lines\n" );
+                    return { _errno_status( errno ), Line( ) };
                 }
             }
-            else if( is_None( ch_info.pwm_chip_dir ) )
+            else if( !is_None( ch_info->pwm_chip_dir( ) ) )
             {
-                if( direction == OUT )
-                {
-                    _setup_single_out( ch_info, initial );
-                }
-                else if( direction == IN )
-                {
-                    if( initial != -1 )
-                    {
-                        throw runtime_error(
-                            "initial parameter is not valid for inputs" );
-                    }
-                    _setup_single_in( ch_info );
-                }
-                else
-                {
-                    throw runtime_error(
-                        "GPIO direction must be GPIO::IN or GPIO::OUT" );
-                }
+                // Nothing is requested, the pin is driven by its PWM chip
+                return { Status::NOT_GPIO, Line( ) };
+            }
+            else if( direction == OUT )
+            {
+                _setup_single_out( *ch_info, initial );
             }
+            else if( initial != -1 )
+            {
+                return { Status::INVALID_ARGUMENT, Line( ) };
+            }
+            else
+            {
+                _setup_single_in( *ch_info );
+            }
+
+            return { Status::OK, Line( &state ) };
         }
-        catch( exception &e )
+        catch( ... )
+        {
+            return { _exception_status( ), Line( ) };
+        }
+    }
+
+    Result<Line> try_setup( int channel, Directions direction,
+                            int initial ) noexcept
+    {
+        return try_setup( to_string( channel ), direction, initial );
+    }
+
+    Line setup( const string &channel, Directions direction, int initial )
+    {
+        try
+        {
+            Status             status;
+            const ChannelInfo *ch_info = _find_channel( channel, status );
+
+            if( global._gpio_warnings && ch_info != nullptr )
+            {
+                Directions app_cfg   = _app_channel_configuration( *ch_info );
+                Directions gpiod_cfg = _channel_configuration( *ch_info );
+
+                if( app_cfg != UNKNOWN && gpiod_cfg != UNKNOWN )
+                {
+                    cerr << "[WARNING] This channel is already in use, "
+                            "continuing anyway. "
+                            "Use GPIO::setwarnings(false) to "
+                            "disable warnings.\n";
+                }
+            }
+        }
+        catch( exception &e )
         {
             cerr << "[Exception] " << e.what( ) << " (caught from: setup())"
                  << endl;
+            return Line( );
+        }
+
+        Result<Line> result = try_setup( channel, direction, initial );
+        if( result.status == Status::PWM_IN_USE )
+        {
+            _print_status( result.status, "GPIO::setup()" );
+            _cleanup_all( );
+            terminate( );
         }
+        // Like it always did, setup() of a hardware PWM pin does nothing
+        else if( !result.ok( ) && result.status != Status::NOT_GPIO )
+        {
+            _print_status( result.status, "setup()" );
+        }
+
+        return result.value;
+    }
+
+    Line setup( int channel, Directions direction, int initial )
+    {
+        return setup( to_string( channel ), direction, initial );
+    }
+
+    string _channel_name( int channel )
+    {
+        return to_string( channel );
+    }
+
+    const string &_channel_name( const string &channel )
+    {
+        return channel;
     }
 
-    void setup( int channel, Directions direction, int initial )
+    /*
+    Set up a list of channels. The lines not requested yet by this process
+    are requested together, with one line request per gpiochip, so that
+    output() on a list of them needs one call per gpiochip.
+    */
+    void _setup_list( const vector<string> &channels, Directions direction,
+                      int initial )
     {
-        setup( to_string( channel ), direction, initial );
+        try
+        {
+            if( direction != OUT && direction != IN )
+            {
+                throw runtime_error(
+                    "GPIO direction must be GPIO::IN or GPIO::OUT" );
+            }
+
+            map<int, vector<const ChannelInfo *>> new_lines{ };
+
+            for( const auto &channel : channels )
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                LineState         &state   = _line_state( ch_info );
+
+                if( state.request != NULL ||
+                    !is_None( ch_info.pwm_chip_dir( ) ) ||
+                    _is_pwm_channel( channel ) )
+                {
+                    setup( channel, direction, initial );
+                    continue;
+                }
+
+                auto &lines = new_lines[ch_info.chip_gpio];
+                if( std::none_of( lines.begin( ), lines.end( ),
+                                  [&state]( const ChannelInfo *line ) {
+                                      return &_line_state( *line ) == &state;
+                                  } ) )
+                {
+                    lines.push_back( &ch_info );
+                }
+            }
+
+            for( const auto &_pair : new_lines )
+            {
+                lock_guard<recursive_mutex> lock(
+                    _line_state( *_pair.second.front( ) ).chip_lock );
+
+                // Lines requested by another thread since they were checked
+                vector<const ChannelInfo *> lines{ };
+                for( const ChannelInfo *ch_info : _pair.second )
+                {
+                    if( _line_state( *ch_info ).request != NULL )
+                    {
+                        setup( ch_info->channel, direction, initial );
+                    }
+                    else
+                    {
+                        lines.push_back( ch_info );
+                    }
+                }
+
+                if( !lines.empty( ) )
+                {
+                    _request_lines( _pair.first, lines, direction, initial );
+                }
+            }
+        }
+        catch( exception &e )
+        {
+            cerr << "[Exception] " << e.what( ) << " (caught from: setup())"
+                 << endl;
+        }
     }
 
     template <typename T>
@@ -569,10 +1056,13 @@ namespace GPIO
             throw runtime_error( "initial parameter is not valid for inputs" );
         }
 
+        vector<string> names{ };
         for( const auto &c : channels )
         {
-            setup( c, direction, initial );
+            names.push_back( _channel_name( c ) );
         }
+
+        _setup_list( names, direction, initial );
     }
 
     /*
@@ -580,32 +1070,60 @@ namespace GPIO
     Function returns either HIGH or LOW
     */
 
-    int input( const string &channel )
+    Result<int> try_input( const string &channel ) noexcept
     {
-        try
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
         {
-            ChannelInfo ch_info = _channel_to_info( channel, true );
+            return { status, LOW };
+        }
 
-            Directions  app_cfg = _app_channel_configuration( ch_info );
+        // request is set before direction is stored
+        LineState &state = _line_state( *ch_info );
+        LineUse    use( state );
+        Directions app_cfg = state.direction.load( memory_order_acquire );
+        if( app_cfg != IN && app_cfg != OUT )
+        {
+            return { Status::NOT_SET_UP, LOW };
+        }
 
-            if( app_cfg != IN && app_cfg != OUT )
-            {
-                throw runtime_error(
-                    "You must setup() the GPIO channel first" );
-            }
+        if( state.mirror.enabled.load( memory_order_acquire ) )
+        {
+            return { Status::OK,
+                     state.mirror.value.load( memory_order_acquire ) };
+        }
 
-            gpiod_line_value value_read;
-            value_read = gpiod_line_request_get_value(
-                channelLineRequest[ch_info.gpio], ch_info.gpio );
-            return value_read;
+        int value = state.request->get_value( ch_info->gpio );
+        if( value == -1 )
+        {
+            return { _errno_status( errno ), LOW };
         }
 
-        catch( exception &e )
+        return { Status::OK, value };
+    }
+
+    Result<int> try_input( int channel ) noexcept
+    {
+        return try_input( to_string( channel ) );
+    }
+
+    int input( const string &channel )
+    {
+        Result<int> result = try_input( channel );
+
+        // A line that can't be read has always given -1
+        if( _is_driver_error( result.status ) )
         {
-            cerr << "[Exception] " << e.what( ) << " (caught from: input())"
-                 << endl;
+            return -1;
+        }
+        else if( !result.ok( ) )
+        {
+            _print_status( result.status, "input()" );
             terminate( );
         }
+
+        return result.value;
     }
 
     int input( int channel )
@@ -613,40 +1131,276 @@ namespace GPIO
         return input( to_string( channel ) );
     }
 
+    /*
+    Write an output line with the write lock of its request held, so that the
+    value set and driven change as one step for the other writers of the line
+    */
+    static Status _write_line( LineState &state, int value ) noexcept
+    {
+        int ret = state.request->set_value( state.offset, value );
+        state.driven.store( ret == -1 ? -1 : value, memory_order_relaxed );
+        state.writes.fetch_add( 1, memory_order_relaxed );
+
+        return ret == -1 ? _errno_status( errno ) : Status::OK;
+    }
+
+    /*
+    Drive an output line, skipping the write when the line already drives the
+    value unless force is set. The line must be entered.
+    */
+    static Status _drive_line( LineState &state, int value,
+                               bool force ) noexcept
+    {
+        value = value == 1 ? HIGH : LOW;
+
+        if( !force && state.driven.load( memory_order_relaxed ) == value )
+        {
+            state.elided.fetch_add( 1, memory_order_relaxed );
+            return Status::OK;
+        }
+
+        lock_guard<mutex> lock( state.line_request->write_lock );
+        return _write_line( state, value );
+    }
+
+    /*
+    Value the output line should be toggled to, -1 if it can't be read.
+    Called with the write lock of the request held, so that no write of
+    another thread lands between reading the value and writing its inverse.
+    */
+    static int _toggled_value( LineState &state ) noexcept
+    {
+        int value = state.driven.load( memory_order_relaxed );
+        if( value == -1 )
+        {
+            value = state.request->get_value( state.offset );
+            if( value == -1 )
+            {
+                return -1;
+            }
+        }
+
+        return value == HIGH ? LOW : HIGH;
+    }
+
+    static Status _toggle_line( LineState &state ) noexcept
+    {
+        lock_guard<mutex> lock( state.line_request->write_lock );
+
+        int value = _toggled_value( state );
+        if( value == -1 )
+        {
+            return _errno_status( errno );
+        }
+
+        return _write_line( state, value );
+    }
+
+    // The line of a channel, nullptr with status if it isn't a channel
+    static LineState *_channel_line_state( const string &channel,
+                                           Status       &status ) noexcept
+    {
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        return ch_info != nullptr ? &_line_state( *ch_info ) : nullptr;
+    }
+
+    /*
+    State of a channel set up as an output, entered with use, nullptr with
+    status otherwise
+    */
+    static LineState *_output_line_state( const string &channel, LineUse &use,
+                                          Status &status ) noexcept
+    {
+        LineState *state = _channel_line_state( channel, status );
+        if( state == nullptr )
+        {
+            return nullptr;
+        }
+
+        // request is set before direction is stored
+        use = LineUse( *state );
+        if( state->direction.load( memory_order_acquire ) != OUT )
+        {
+            status = Status::NOT_OUTPUT;
+            return nullptr;
+        }
+
+        return state;
+    }
+
     /*
     Function used to set a value to a channel.
     Values must be either HIGH or LOW
     */
 
-    void output( const string &channel, int value )
+    Status try_output( const string &channel, int value, bool force ) noexcept
+    {
+        Status     status;
+        LineUse    use{ };
+        LineState *state = _output_line_state( channel, use, status );
+        if( state == nullptr )
+        {
+            return status;
+        }
+
+        return _drive_line( *state, value, force );
+    }
+
+    Status try_output( int channel, int value, bool force ) noexcept
+    {
+        return try_output( to_string( channel ), value, force );
+    }
+
+    void output( const string &channel, int value, bool force )
+    {
+        Status status = try_output( channel, value, force );
+        if( status != Status::OK )
+        {
+            _print_status( status, "output()" );
+        }
+    }
+
+    void output( int channel, int value, bool force )
+    {
+        output( to_string( channel ), value, force );
+    }
+
+    // Scratch buffers of the list output() and toggle(), kept by each thread
+    // calling them so that they don't allocate on every call
+    struct OutputListBuffers
+    {
+        vector<string>                 names;
+        vector<int>                    values;
+        vector<LineState *>            states;
+        vector<LineUse>                uses;
+        vector<pair<LineState *, int>> writes; // line and value, by request
+        vector<unsigned int>           offsets;
+        vector<int>                    request_values;
+    };
+
+    static OutputListBuffers &_output_list_buffers( )
+    {
+        static thread_local OutputListBuffers buffers{ };
+        return buffers;
+    }
+
+    /*
+    Set the values of a list of channels with one set values call per line
+    request, so that the lines of a request change at the same time.
+    Without values every line is toggled. Lines already driving their value
+    are left out unless force is set.
+    */
+    static void _output_list( const vector<string> &channels,
+                              const vector<int> *values, bool force )
     {
+        OutputListBuffers              &buffers = _output_list_buffers( );
+        vector<LineState *>            &states  = buffers.states;
+        vector<pair<LineState *, int>> &writes  = buffers.writes;
+        vector<unsigned int>           &offsets = buffers.offsets;
+        vector<int>                    &request_values = buffers.request_values;
+
+        states.clear( );
+        writes.clear( );
+
         try
         {
-            gpiod_line_value gpio_val;
-            ChannelInfo      ch_info = _channel_to_info( channel, true );
-            // check that the channel has been set as output
-            if( _app_channel_configuration( ch_info ) != OUT )
+            for( const auto &channel : channels )
             {
-                throw runtime_error(
-                    "The GPIO channel has not been set up as an OUTPUT" );
+                Status     status;
+                LineState *state = _channel_line_state( channel, status );
+                if( state == nullptr )
+                {
+                    throw runtime_error( status_string( status ) );
+                }
+                states.push_back( state );
             }
 
-            if( value == 1 )
+            // The lines are entered together, their requests stay in place
+            // until every request is written
+            _enter_lines( states, buffers.uses );
+
+            for( size_t i = 0; i < channels.size( ); i++ )
             {
-                gpio_val = GPIOD_LINE_VALUE_ACTIVE;
+                LineState &state = *states[i];
+                if( state.direction.load( memory_order_acquire ) != OUT )
+                {
+                    throw runtime_error( status_string( Status::NOT_OUTPUT ) );
+                }
+
+                // Toggled values are read once the write lock is held
+                int value = LOW;
+                if( values != nullptr )
+                {
+                    value = ( *values )[i] == 1 ? HIGH : LOW;
+                    if( !force &&
+                        state.driven.load( memory_order_relaxed ) == value )
+                    {
+                        state.elided.fetch_add( 1, memory_order_relaxed );
+                        continue;
+                    }
+                }
+
+                // Kept sorted by request in list order, by insertion since
+                // the lists are short and stable_sort() allocates
+                auto later = upper_bound(
+                    writes.begin( ), writes.end( ), state.request,
+                    []( BackendRequest *request,
+                        const pair<LineState *, int> &write )
+                    { return request < write.first->request; } );
+                writes.insert( later, { &state, value } );
             }
-            else
+
+            for( size_t first = 0; first < writes.size( ); )
             {
-                gpio_val = GPIOD_LINE_VALUE_INACTIVE;
-            }
+                BackendRequest *request = writes[first].first->request;
+                size_t          last    = first;
+                while( last < writes.size( ) &&
+                       writes[last].first->request == request )
+                {
+                    last++;
+                }
 
-            int status = gpiod_line_request_set_value(
-                channelLineRequest[ch_info.gpio], ch_info.gpio, gpio_val );
+                lock_guard<mutex> lock(
+                    writes[first].first->line_request->write_lock );
 
-            if( status == -1 )
-            {
-                throw runtime_error(
-                    "Could not set the pin to the given value\n" );
+                offsets.clear( );
+                request_values.clear( );
+                for( size_t i = first; i < last; i++ )
+                {
+                    LineState &state = *writes[i].first;
+                    if( values == nullptr )
+                    {
+                        writes[i].second = _toggled_value( state );
+                        if( writes[i].second == -1 )
+                        {
+                            throw runtime_error( "Could not read channel " +
+                                                 state.channel );
+                        }
+                    }
+
+                    offsets.push_back( state.offset );
+                    request_values.push_back( writes[i].second );
+                }
+
+                int status = request->set_values(
+                    offsets.size( ), offsets.data( ), request_values.data( ) );
+
+                for( size_t i = first; i < last; i++ )
+                {
+                    writes[i].first->driven.store(
+                        status == -1 ? -1 : writes[i].second,
+                        memory_order_relaxed );
+                    writes[i].first->writes.fetch_add( 1,
+                                                       memory_order_relaxed );
+                }
+
+                if( status == -1 )
+                {
+                    throw runtime_error(
+                        "Could not set the pins to the given values\n" );
+                }
+
+                first = last;
             }
         }
         catch( exception &e )
@@ -654,471 +1408,1273 @@ namespace GPIO
             cerr << "[Exception] " << e.what( ) << " (caught from: output())"
                  << endl;
         }
+
+        buffers.uses.clear( );
+    }
+
+    template <typename T>
+    void output( const std::initializer_list<T> &channels, int value,
+                 bool force )
+    {
+        OutputListBuffers &buffers = _output_list_buffers( );
+        buffers.names.clear( );
+        for( const auto &c : channels )
+        {
+            buffers.names.push_back( _channel_name( c ) );
+        }
+
+        buffers.values.assign( buffers.names.size( ), value );
+        _output_list( buffers.names, &buffers.values, force );
+    }
+
+    template <typename T>
+    void output( const std::initializer_list<T>   &channels,
+                 const std::initializer_list<int> &values, bool force )
+    {
+        if( channels.size( ) != values.size( ) )
+        {
+            throw runtime_error( "Number of values != number of channels" );
+        }
+
+        OutputListBuffers &buffers = _output_list_buffers( );
+        buffers.names.clear( );
+        for( const auto &c : channels )
+        {
+            buffers.names.push_back( _channel_name( c ) );
+        }
+
+        buffers.values.assign( values );
+        _output_list( buffers.names, &buffers.values, force );
+    }
+
+    /*
+    Function used to invert the value of a channel set up as an output.
+    */
+
+    Status try_toggle( const string &channel ) noexcept
+    {
+        Status     status;
+        LineUse    use{ };
+        LineState *state = _output_line_state( channel, use, status );
+        if( state == nullptr )
+        {
+            return status;
+        }
+
+        return _toggle_line( *state );
+    }
+
+    Status try_toggle( int channel ) noexcept
+    {
+        return try_toggle( to_string( channel ) );
+    }
+
+    void toggle( const string &channel )
+    {
+        Status status = try_toggle( channel );
+        if( status != Status::OK )
+        {
+            _print_status( status, "toggle()" );
+        }
     }
 
-    void output( int channel, int value )
+    void toggle( int channel )
     {
-        output( to_string( channel ), value );
+        toggle( to_string( channel ) );
     }
 
     template <typename T>
-    void output( const std::initializer_list<T> &channels, int value )
+    void toggle( const std::initializer_list<T> &channels )
     {
+        OutputListBuffers &buffers = _output_list_buffers( );
+        buffers.names.clear( );
         for( const auto &c : channels )
         {
-            output( c, value );
+            buffers.names.push_back( _channel_name( c ) );
+        }
+
+        _output_list( buffers.names, nullptr, true );
+    }
+
+    OutputStats output_stats( )
+    {
+        // Counted per line, so that threads writing different lines don't
+        // share a counter
+        OutputStats stats{ 0, 0 };
+        for( const auto &_pair : line_states )
+        {
+            stats.writes += _pair.second.writes.load( memory_order_relaxed );
+            stats.elided += _pair.second.elided.load( memory_order_relaxed );
         }
+
+        return stats;
     }
 
-    template <typename T>
-    void output( const std::initializer_list<T>   &channels,
-                 const std::initializer_list<int> &values )
-    {
-        if( channels.size( ) != values.size( ) )
-        {
-            throw runtime_error( "Number of values != number of channels" );
-        }
+    void reset_output_stats( )
+    {
+        for( auto &_pair : line_states )
+        {
+            _pair.second.writes = 0;
+            _pair.second.elided = 0;
+        }
+    }
+
+    /*
+    Function used to check the currently set function of the channel specified.
+    */
+
+    Directions gpio_function( const string &channel )
+    {
+        try
+        {
+            ChannelInfo ch_info = _channel_to_info( channel );
+            return _channel_configuration( ch_info );
+        }
+        catch( exception &e )
+        {
+            cerr << "[Exception] " << e.what( )
+                 << " (caught from: gpio_function())" << endl;
+            terminate( );
+        }
+    }
+
+    Directions gpio_function( int channel )
+    {
+        return gpio_function( to_string( channel ) );
+    }
+
+    //=============================== LINE HANDLE ============================
+
+    Line::Line( LineState *state ) : pImpl( state )
+    {
+    }
+
+    Result<int> Line::try_read( ) const noexcept
+    {
+        if( pImpl == nullptr )
+        {
+            return { Status::NOT_SET_UP, LOW };
+        }
+
+        LineUse use( *pImpl );
+        if( pImpl->direction != IN && pImpl->direction != OUT )
+        {
+            return { Status::NOT_SET_UP, LOW };
+        }
+
+        if( pImpl->mirror.enabled.load( memory_order_acquire ) )
+        {
+            return { Status::OK,
+                     pImpl->mirror.value.load( memory_order_acquire ) };
+        }
+
+        int value = pImpl->request->get_value( pImpl->offset );
+        if( value == -1 )
+        {
+            return { _errno_status( errno ), LOW };
+        }
+
+        return { Status::OK, value };
+    }
+
+    Status Line::try_write( int value, bool force ) const noexcept
+    {
+        if( pImpl == nullptr )
+        {
+            return Status::NOT_OUTPUT;
+        }
+
+        LineUse use( *pImpl );
+        if( pImpl->direction != OUT )
+        {
+            return Status::NOT_OUTPUT;
+        }
+
+        return _drive_line( *pImpl, value, force );
+    }
+
+    Status Line::try_toggle( ) const noexcept
+    {
+        if( pImpl == nullptr )
+        {
+            return Status::NOT_OUTPUT;
+        }
+
+        LineUse use( *pImpl );
+        if( pImpl->direction != OUT )
+        {
+            return Status::NOT_OUTPUT;
+        }
+
+        return _toggle_line( *pImpl );
+    }
+
+    int Line::read( ) const
+    {
+        Result<int> result = try_read( );
+
+        // A line that can't be read has always given -1
+        if( _is_driver_error( result.status ) )
+        {
+            return -1;
+        }
+        else if( !result.ok( ) )
+        {
+            _print_status( result.status, "Line::read()" );
+            terminate( );
+        }
+
+        return result.value;
+    }
+
+    void Line::write( int value, bool force ) const
+    {
+        Status status = try_write( value, force );
+        if( status != Status::OK )
+        {
+            _print_status( status, "Line::write()" );
+        }
+    }
+
+    void Line::toggle( ) const
+    {
+        Status status = try_toggle( );
+        if( status != Status::OK )
+        {
+            _print_status( status, "Line::toggle()" );
+        }
+    }
+
+    Directions Line::direction( ) const
+    {
+        return pImpl != nullptr ? pImpl->direction.load( ) : UNKNOWN;
+    }
+
+    bool Line::valid( ) const
+    {
+        return pImpl != nullptr;
+    }
+
+    //=============================== EVENTS =================================
+
+    Result<int> try_event_detected( const std::string &channel ) noexcept
+    {
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return { status, 0 };
+        }
+
+        // channel must be setup as input
+        LineState &state = _line_state( *ch_info );
+        if( state.direction.load( memory_order_acquire ) != Directions::IN )
+        {
+            return { Status::NOT_INPUT, 0 };
+        }
+
+        // Events dispatched since the last call
+        return { Status::OK, state.events_detected.exchange( 0 ) };
+    }
+
+    Result<int> try_event_detected( int channel ) noexcept
+    {
+        return try_event_detected( std::to_string( channel ) );
+    }
+
+    int event_detected( const std::string &channel )
+    {
+        Result<int> result = try_event_detected( channel );
+        if( !result.ok( ) )
+        {
+            _print_status( result.status, "GPIO::event_detected()" );
+            _cleanup_all( );
+            terminate( );
+        }
+
+        return result.value;
+    }
+
+    int event_detected( int channel )
+    {
+        return event_detected( std::to_string( channel ) );
+    }
+
+    Result<unsigned long>
+    try_events_dropped( const std::string &channel ) noexcept
+    {
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return { status, 0 };
+        }
+
+        // channel must be setup as input
+        LineState &state = _line_state( *ch_info );
+        if( state.direction.load( memory_order_acquire ) != Directions::IN )
+        {
+            return { Status::NOT_INPUT, 0 };
+        }
+
+        return { Status::OK, state.events_dropped.load( ) };
+    }
+
+    Result<unsigned long> try_events_dropped( int channel ) noexcept
+    {
+        return try_events_dropped( std::to_string( channel ) );
+    }
+
+    unsigned long events_dropped( const std::string &channel )
+    {
+        Result<unsigned long> result = try_events_dropped( channel );
+        if( !result.ok( ) )
+        {
+            _print_status( result.status, "GPIO::events_dropped()" );
+            _cleanup_all( );
+            terminate( );
+        }
+
+        return result.value;
+    }
+
+    unsigned long events_dropped( int channel )
+    {
+        return events_dropped( std::to_string( channel ) );
+    }
+
+    Status try_add_event_callback( const std::string &channel,
+                                   const Callback    &callback ) noexcept
+    {
+        // Argument Check
+        if( callback == nullptr )
+        {
+            return Status::INVALID_ARGUMENT;
+        }
+
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return status;
+        }
+
+        // Not under the chip lock, dispatching events doesn't delay this
+        LineState        &state = _line_state( *ch_info );
+        lock_guard<mutex> lock( state.callbacks_lock );
+
+        // channel must be setup as input
+        if( state.direction != Directions::IN )
+        {
+            return Status::NOT_INPUT;
+        }
+
+        // edge event must already exist
+        if( state.user_edge == Edge::NONE )
+        {
+            return Status::NOT_DETECTING;
+        }
+
+        // Execute, copying the list and the callback may allocate
+        try
+        {
+            auto current = std::atomic_load_explicit( &state.callbacks,
+                                                      memory_order_acquire );
+            auto list    = current != nullptr
+                               ? std::make_shared<CallbackList>( *current )
+                               : std::make_shared<CallbackList>( );
+            list->push_back( callback );
+            _store_callbacks( state, std::move( list ) );
+        }
+        catch( ... )
+        {
+            return _exception_status( );
+        }
+
+        return Status::OK;
+    }
+
+    Status try_add_event_callback( int             channel,
+                                   const Callback &callback ) noexcept
+    {
+        return try_add_event_callback( std::to_string( channel ), callback );
+    }
+
+    void add_event_callback( const std::string &channel,
+                             const Callback    &callback )
+    {
+        Status status = try_add_event_callback( channel, callback );
+        if( status != Status::OK )
+        {
+            _print_status( status, "GPIO::add_event_callback()" );
+            _cleanup_all( );
+            terminate( );
+        }
+    }
+
+    void add_event_callback( int channel, const Callback &callback )
+    {
+        add_event_callback( std::to_string( channel ), callback );
+    }
+
+    Status try_remove_event_callback( const std::string &channel,
+                                      const Callback    &callback ) noexcept
+    {
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return status;
+        }
+
+        LineState        &state = _line_state( *ch_info );
+        lock_guard<mutex> lock( state.callbacks_lock );
+
+        auto current = std::atomic_load_explicit( &state.callbacks,
+                                                  memory_order_acquire );
+        if( current == nullptr )
+        {
+            return Status::NOT_FOUND;
+        }
+
+        auto it = std::find( current->begin( ), current->end( ), callback );
+        if( it == current->end( ) )
+        {
+            return Status::NOT_FOUND;
+        }
+
+        // Execute, copying the list may allocate
+        try
+        {
+            auto list = std::make_shared<CallbackList>( );
+            list->reserve( current->size( ) - 1 );
+            list->insert( list->end( ), current->begin( ), it );
+            list->insert( list->end( ), it + 1, current->end( ) );
+            _store_callbacks( state, std::move( list ) );
+        }
+        catch( ... )
+        {
+            return _exception_status( );
+        }
+
+        return Status::OK;
+    }
+
+    Status try_remove_event_callback( int             channel,
+                                      const Callback &callback ) noexcept
+    {
+        return try_remove_event_callback( std::to_string( channel ),
+                                          callback );
+    }
+
+    void remove_event_callback( const std::string &channel,
+                                const Callback    &callback )
+    {
+        Status status = try_remove_event_callback( channel, callback );
+        if( status != Status::OK )
+        {
+            _print_status( status, "GPIO::remove_event_callback()" );
+            _cleanup_all( );
+            terminate( );
+        }
+    }
+
+    void remove_event_callback( int channel, const Callback &callback )
+    {
+        remove_event_callback( std::to_string( channel ), callback );
+    }
+
+    /*
+    Detect edges on channel, reported to callbacks as event_channel.
+    */
+    static Status _add_event_detect( const std::string &channel,
+                                     int event_channel, Edge edge,
+                                     const Callback     &callback,
+                                     unsigned long       bounce_time,
+                                     const EventBuffers &buffers ) noexcept
+    {
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return status;
+        }
+
+        LineState                  &state = _line_state( *ch_info );
+        lock_guard<recursive_mutex> lock( state.chip_lock );
+
+        // channel must be setup as input
+        if( state.direction != Directions::IN )
+        {
+            return Status::NOT_INPUT;
+        }
+
+        // edge provided must be rising, falling or both
+        if( edge != Edge::RISING && edge != Edge::FALLING &&
+            edge != Edge::BOTH )
+        {
+            return Status::INVALID_ARGUMENT;
+        }
+
+        // The events of a request waited on are read by wait_for_edges()
+        if( state.line_request->waiter != nullptr )
+        {
+            return Status::BUSY;
+        }
+
+        if( buffers.read_events == 0 ||
+            buffers.kernel_events > MAX_EVENT_BUFFER_SIZE )
+        {
+            return Status::INVALID_ARGUMENT;
+        }
+
+        // The kernel buffer is only ever enlarged, other lines of the
+        // request may rely on its current size
+        try
+        {
+            const LineRequest &line_request = *state.line_request;
+            size_t             kernel_events =
+                line_request.event_buffer_size != 0
+                                ? line_request.event_buffer_size
+                                : 16 * line_request.lines.size( );
+            if( buffers.kernel_events > kernel_events )
+            {
+                _request_again( state, buffers.kernel_events );
+            }
+
+            state.events.resize( buffers.read_events );
+            _size_request_events( *state.line_request );
+        }
+        catch( ... )
+        {
+            return _exception_status( );
+        }
+        state.events_dropped = 0;
+
+        // A mirrored input keeps detecting both edges
+        state.user_edge          = edge;
+        state.config.edge        = state.mirror.enabled ? Edge::BOTH : edge;
+        state.config.debounce_us = TIME_MS_TO_US( bounce_time );
+
+        if( _apply_line_settings( state ) == -1 )
+        {
+            return _errno_status( errno );
+        }
+
+        // Execute
+        if( callback != nullptr )
+        {
+            status = try_add_event_callback( channel, callback );
+            if( status != Status::OK )
+            {
+                return status;
+            }
+        }
+
+        try
+        {
+            state.event_channel = event_channel;
+            EventEngine::get_instance( ).watch( state );
+        }
+        catch( ... )
+        {
+            return _exception_status( );
+        }
+
+        return Status::OK;
+    }
+
+    Status try_add_event_detect( const std::string &channel, Edge edge,
+                                 const Callback     &callback,
+                                 unsigned long       bounce_time,
+                                 const EventBuffers &buffers ) noexcept
+    {
+        return _add_event_detect( channel, std::atoi( channel.data( ) ), edge,
+                                  callback, bounce_time, buffers );
+    }
+
+    Status try_add_event_detect( int channel, Edge edge,
+                                 const Callback     &callback,
+                                 unsigned long       bounce_time,
+                                 const EventBuffers &buffers ) noexcept
+    {
+        return _add_event_detect( std::to_string( channel ), channel, edge,
+                                  callback, bounce_time, buffers );
+    }
+
+    void add_event_detect( const std::string &channel, Edge edge,
+                           const Callback &callback, unsigned long bounce_time,
+                           const EventBuffers &buffers )
+    {
+        Status status = try_add_event_detect( channel, edge, callback,
+                                              bounce_time, buffers );
+        if( status != Status::OK )
+        {
+            _print_status( status, "GPIO::add_event_detect()" );
+            _cleanup_all( );
+            terminate( );
+        }
+    }
+
+    void add_event_detect( int channel, Edge edge, const Callback &callback,
+                           unsigned long       bounce_time,
+                           const EventBuffers &buffers )
+    {
+        Status status = try_add_event_detect( channel, edge, callback,
+                                              bounce_time, buffers );
+        if( status != Status::OK )
+        {
+            _print_status( status, "GPIO::add_event_detect()" );
+            _cleanup_all( );
+            terminate( );
+        }
+    }
+
+    Status try_remove_event_detect( const std::string &channel ) noexcept
+    {
+        Status             status;
+        const ChannelInfo *ch_info = _find_channel( channel, status );
+        if( ch_info == nullptr )
+        {
+            return status;
+        }
+
+        LineState                  &state = _line_state( *ch_info );
+        lock_guard<recursive_mutex> lock( state.chip_lock );
+
+        {
+            lock_guard<mutex> callbacks_lock( state.callbacks_lock );
+            state.user_edge = Edge::NONE;
+            _store_callbacks( state, nullptr );
+        }
+
+        // A mirrored input stays watched to keep its mirror up to date.
+        // Otherwise the kernel stops detecting edges, as they would still
+        // wake up the event thread for the other lines of a merged request.
+        if( !state.mirror.enabled )
+        {
+            EventEngine::get_instance( ).unwatch( state );
+
+            if( state.line_request != nullptr &&
+                state.config.edge != Edge::NONE )
+            {
+                state.config.edge = Edge::NONE;
+                if( _apply_line_settings( state ) == -1 )
+                {
+                    return _errno_status( errno );
+                }
+            }
+        }
+
+        return Status::OK;
+    }
+
+    Status try_remove_event_detect( int channel ) noexcept
+    {
+        return try_remove_event_detect( std::to_string( channel ) );
+    }
+
+    void remove_event_detect( const std::string &channel )
+    {
+        Status status = try_remove_event_detect( channel );
+        if( status != Status::OK )
+        {
+            throw runtime_error( status_string( status ) );
+        }
+    }
+
+    void remove_event_detect( int channel )
+    {
+        remove_event_detect( std::to_string( channel ) );
+    }
+
+    // A line armed for edge events by _wait_for_edges()
+    struct WaitedLine
+    {
+        LineState *state;
+        int        channel;
+    };
+
+    /*
+    Let other calls wait on the requests of the lines armed by the call of
+    _wait_for_edges() identified by waiter
+    */
+    static void _release_lines( const vector<WaitedLine> &lines,
+                                const void               *waiter )
+    {
+        for( const WaitedLine &line : lines )
+        {
+            LineState                  &state = *line.state;
+            lock_guard<recursive_mutex> lock( state.chip_lock );
+
+            // The line may have been cleaned up or set up again meanwhile
+            if( state.line_request != nullptr &&
+                state.line_request->waiter == waiter )
+            {
+                state.line_request->waiter = nullptr;
+            }
+        }
+    }
+
+    // Scratch buffers of _wait_for_edges(), kept by each thread calling it
+    // so a loop waiting for edges doesn't allocate them on every call
+    struct WaitBuffers
+    {
+        vector<WaitedLine>              lines;
+        vector<shared_ptr<LineRequest>> requests;
+        vector<pollfd>                  fds;
+        vector<EdgeEvent>               events;
+    };
+
+    /*
+    Wait for the edge on any of channels, giving in result the events read
+    once one occurred, oldest first, or none after timeout. The lines are
+    armed under their chip lock, then their request fds are polled together
+    with no lock held. A request is waited on by a single call at a time, and
+    isn't watched by the event thread meanwhile, so its events are read here
+    only. The lines keep detecting the edge afterwards, the edges occurring
+    between two calls are returned by the next one, and a line already armed
+    for the edge isn't reconfigured again.
+    */
+    static void _wait_for_edges( const vector<string> &channels, Edge edge,
+                                 unsigned long bounce_time, int64_t timeout,
+                                 vector<EdgeEvent> &result )
+    {
+        // edge provided must be rising, falling or both
+        if( edge != Edge::RISING && edge != Edge::FALLING &&
+            edge != Edge::BOTH )
+        {
+            throw invalid_argument( "argument 'edge' must be set to "
+                                    "RISING, FALLING or BOTH" );
+        }
+
+        static thread_local WaitBuffers  buffers{ };
+        vector<WaitedLine>              &lines    = buffers.lines;
+        vector<shared_ptr<LineRequest>> &requests = buffers.requests;
+        vector<pollfd>                  &fds      = buffers.fds;
+        const void                      *waiter   = &lines;
+
+        // The requests aren't kept past the call, cleanup() may release them
+        auto release = [&]( ) {
+            _release_lines( lines, waiter );
+            lines.clear( );
+            requests.clear( );
+        };
+        lines.clear( );
+        requests.clear( );
+        fds.clear( );
+        result.clear( );
+        if( buffers.events.empty( ) )
+        {
+            buffers.events.resize( MAX_EVENTS );
+        }
+
+        try
+        {
+            for( const string &channel : channels )
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                LineState         &state   = _line_state( ch_info );
+
+                lock_guard<recursive_mutex> lock( state.chip_lock );
+
+                // channel must be setup as input
+                if( state.direction != Directions::IN )
+                {
+                    throw runtime_error(
+                        "You must setup() the GPIO channel as an input first" );
+                }
+
+                // The event thread reads the edge events of the lines of a
+                // request it watches, mirrored inputs included
+                LineRequest &line_request = *state.line_request;
+                for( LineState *line : line_request.lines )
+                {
+                    if( line->watched )
+                    {
+                        throw runtime_error(
+                            "wait_for_edge() can't be used on a line "
+                            "detecting events, or sharing its line request "
+                            "with one" );
+                    }
+                }
+
+                if( line_request.waiter != nullptr &&
+                    line_request.waiter != waiter )
+                {
+                    throw runtime_error( "Another thread waits for edges on "
+                                         "the line request of channel " +
+                                         channel );
+                }
+
+                bool armed = false;
+                for( const WaitedLine &line : lines )
+                {
+                    armed = armed || line.state == &state;
+                }
+                if( armed )
+                {
+                    continue;
+                }
+
+                lines.push_back( { &state, std::atoi( channel.data( ) ) } );
+                if( line_request.waiter == nullptr )
+                {
+                    line_request.waiter = waiter;
+                    requests.push_back( state.line_request );
+                }
+
+                unsigned long debounce_us = TIME_MS_TO_US( bounce_time );
+                if( state.config.edge == edge &&
+                    state.config.debounce_us == debounce_us )
+                {
+                    continue;
+                }
+
+                state.config.edge        = edge;
+                state.config.debounce_us = debounce_us;
+                if( _apply_line_settings( state ) == -1 )
+                {
+                    throw runtime_error(
+                        "Lines could not be reconfigured for edge events\n" );
+                }
+            }
+
+            for( const auto &line_request : requests )
+            {
+                fds.push_back( { line_request->request->fd( ), POLLIN, 0 } );
+            }
+
+            vector<EdgeEvent> &events = buffers.events;
+            auto               deadline =
+                chrono::steady_clock::now( ) + chrono::milliseconds( timeout );
+
+            while( result.empty( ) )
+            {
+                int wait_ms = -1;
+                if( timeout >= 0 )
+                {
+                    auto left = chrono::duration_cast<chrono::milliseconds>(
+                        deadline - chrono::steady_clock::now( ) );
+                    wait_ms = int( std::max<int64_t>( left.count( ), 0 ) );
+                }
+
+                int ready = poll( fds.data( ), fds.size( ), wait_ms );
+                if( ready == -1 && errno == EINTR )
+                {
+                    continue;
+                }
+                if( ready == -1 )
+                {
+                    throw runtime_error( "Wait Event Error Occured: " +
+                                         string( strerror( errno ) ) );
+                }
+                if( ready == 0 )
+                {
+                    break;
+                }
+
+                for( size_t i = 0; i < fds.size( ); i++ )
+                {
+                    if( ( fds[i].revents & POLLIN ) == 0 )
+                    {
+                        continue;
+                    }
+
+                    const LineRequest &line_request = *requests[i];
+                    int                count =
+                        line_request.request->read_edge_events(
+                            events.data( ), events.size( ) );
+                    if( count == -1 )
+                    {
+                        throw runtime_error( "Could not read edge events" );
+                    }
+
+                    // Lines of the request that aren't waited on get none
+                    for( int j = 0; j < count; j++ )
+                    {
+                        EdgeEvent &event = events[j];
+                        if( edge != Edge::BOTH && event.edge != edge )
+                        {
+                            continue; // queued before the edge was changed
+                        }
+
+                        for( const WaitedLine &line : lines )
+                        {
+                            if( line.state->offset == event.offset &&
+                                line.state->request ==
+                                    line_request.request.get( ) )
+                            {
+                                event.channel = line.channel;
+                                result.push_back( event );
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
 
-        auto c = channels.begin( );
-        auto v = values.begin( );
+            release( );
 
-        for( auto it = channels.begin( ); it != channels.end( ); it++ )
+            // The events of each request are in order already, they are
+            // merged in place since stable_sort() allocates a buffer
+            auto earlier = []( const EdgeEvent &a, const EdgeEvent &b ) {
+                return a.timestamp_ns < b.timestamp_ns;
+            };
+            for( auto it = result.begin( ); it != result.end( ); ++it )
+            {
+                rotate( upper_bound( result.begin( ), it, *it, earlier ), it,
+                        it + 1 );
+            }
+        }
+        catch( ... )
         {
-            output( *c++, *v++ );
+            release( );
+            throw;
         }
     }
 
-    /*
-    Function used to check the currently set function of the channel specified.
-    */
+    int wait_for_edge( const std::string &channel, Edge edge,
+                       unsigned long bounce_time, int64_t timeout )
+    {
+        return wait_for_edge( std::atoi( channel.data( ) ), edge, bounce_time,
+                              timeout );
+    }
 
-    Directions gpio_function( const string &channel )
+    int wait_for_edge( int channel, Edge edge, unsigned long bounce_time,
+                       int64_t timeout )
     {
         try
         {
-            ChannelInfo ch_info = _channel_to_info( channel );
-            return _channel_configuration( ch_info );
+            static thread_local vector<string>    names( 1 );
+            static thread_local vector<EdgeEvent> events{ };
+            names[0] = std::to_string( channel );
+
+            _wait_for_edges( names, edge, bounce_time, timeout, events );
+            return events.empty( ) ? 0 : 1;
         }
         catch( exception &e )
         {
             cerr << "[Exception] " << e.what( )
-                 << " (caught from: gpio_function())" << endl;
+                 << " (caught from: GPIO::wait_for_edge())" << endl;
+            _cleanup_all( );
             terminate( );
         }
     }
 
-    Directions gpio_function( int channel )
+    template <typename T>
+    std::vector<EdgeEvent>
+    wait_for_edges( const std::initializer_list<T> &channels, Edge edge,
+                    unsigned long bounce_time, int64_t timeout )
     {
-        return gpio_function( to_string( channel ) );
+        return wait_for_edges( std::vector<T>( channels ), edge, bounce_time,
+                               timeout );
     }
 
-    //=============================== EVENTS =================================
-
-    int event_detected( const std::string &channel )
+    template <typename T>
+    std::vector<EdgeEvent>
+    wait_for_edges( const std::vector<T> &channels, Edge edge,
+                    unsigned long bounce_time, int64_t timeout )
     {
-        ChannelInfo ch_info = _channel_to_info( channel, true );
+        std::vector<EdgeEvent> events{ };
+        wait_for_edges( channels, edge, events, bounce_time, timeout );
+        return events;
+    }
 
+    template <typename T>
+    void wait_for_edges( const std::vector<T> &channels, Edge edge,
+                         std::vector<EdgeEvent> &events,
+                         unsigned long bounce_time, int64_t timeout )
+    {
         try
         {
-
-            // channel must be setup as input
-            Directions app_cfg = _app_channel_configuration( ch_info );
-            if( app_cfg != Directions::IN )
+            static thread_local vector<string> names{ };
+            names.clear( );
+            for( const auto &c : channels )
             {
-                throw runtime_error(
-                    "You must setup() the GPIO channel as an input first" );
+                names.push_back( _channel_name( c ) );
             }
 
-            int                                    noEvents = 0;
-
-            std::unique_lock<std::recursive_mutex> mutex_lock( _epmutex );
-            noEvents = gpiod_edge_event_buffer_get_num_events(
-                channelEventBuffer[ch_info.gpio] );
-            mutex_lock.unlock( );
-
-            return noEvents;
+            _wait_for_edges( names, edge, bounce_time, timeout, events );
         }
         catch( exception &e )
         {
             cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::event_detected())" << endl;
+                 << " (caught from: GPIO::wait_for_edges())" << endl;
             _cleanup_all( );
             terminate( );
         }
     }
 
-    int event_detected( int channel )
+    /*
+    Count the events the kernel dropped before events, called with the chip
+    lock held. A gap in the sequence numbers means the kernel dropped events
+    because its buffer was full. They start from 1 with each line request.
+    */
+    static unsigned long _count_dropped( LineState &state,
+                                         const EdgeEvent *events, int count )
     {
-        return event_detected( std::to_string( channel ) );
-    }
+        unsigned long dropped = 0;
 
-    void add_event_callback( const std::string &channel,
-                             const Callback    &callback )
-    {
-        try
+        for( int i = 0; i < count; i++ )
         {
-            // Argument Check
-            if( callback == nullptr )
+            unsigned long seqno = events[i].line_seqno;
+            if( seqno > state.last_seqno + 1 )
             {
-                throw invalid_argument( "callback cannot be null" );
+                dropped += seqno - state.last_seqno - 1;
             }
+            state.last_seqno = seqno;
+        }
 
-            ChannelInfo ch_info = _channel_to_info( channel, true );
+        if( dropped != 0 )
+        {
+            state.events_dropped += dropped;
+        }
+        return dropped;
+    }
 
-            // channel must be setup as input
-            Directions app_cfg  = _app_channel_configuration( ch_info );
-            if( app_cfg != Directions::IN )
-            {
-                throw runtime_error(
-                    "You must setup() the GPIO channel as an input first" );
-            }
+    // Apply edge events to the mirror of the input
+    static void _update_mirror( LineState &state, const EdgeEvent *events,
+                                int count, bool overflowed )
+    {
+        // The kernel drops the oldest events, the newest one gives the level.
+        // Edges queued before the mirror was seeded are already in its level.
+        const EdgeEvent &newest = events[count - 1];
+        if( !state.mirror.is_newer( newest.timestamp_ns ) )
+        {
+            return;
+        }
 
-            // edge event must already exist
-            if( gpiod_line_settings_get_edge_detection( line_settings ) ==
-                GPIOD_LINE_EDGE_NONE )
-            {
-                throw runtime_error( "The edge event must have been set via "
-                                     "add_event_detect()" );
-            }
+        state.mirror.update( newest.edge == Edge::RISING ? HIGH : LOW,
+                             newest.timestamp_ns, newest.line_seqno );
 
-            // Execute
-            event_callbacks[ch_info.gpio].push_back( callback );
-        }
-        catch( exception &e )
+        if( overflowed )
         {
-            cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::add_event_callback())" << endl;
-            _cleanup_all( );
-            terminate( );
+            state.mirror.overflowed.store( true, memory_order_relaxed );
         }
     }
 
-    void add_event_callback( int channel, const Callback &callback )
+    // Dispatch the edge events of a line, filtered in place
+    static void _dispatch_line( LineState &state, EdgeEvent *events,
+                                int noEvent )
     {
-        add_event_callback( std::to_string( channel ), callback );
-    }
+        unsigned long dropped = _count_dropped( state, events, noEvent );
 
-    void remove_event_callback( const std::string &channel,
-                                const Callback    &callback )
-    {
-        try
+        if( state.mirror.enabled.load( memory_order_relaxed ) )
         {
-            ChannelInfo ch_info = _channel_to_info( channel, true );
+            _update_mirror( state, events, noEvent, dropped != 0 );
+        }
 
-            auto        it =
-                std::find( event_callbacks[ch_info.gpio].begin( ),
-                           event_callbacks[ch_info.gpio].end( ), callback );
-            if( it == event_callbacks[ch_info.gpio].end( ) )
-            {
-                throw runtime_error( "Callback not found\n" );
-            }
-            else
+        // Keep the edges asked for, the line may detect both for its mirror
+        Edge user_edge = state.user_edge;
+        int  count     = 0;
+        for( int i = 0; i < noEvent; i++ )
+        {
+            if( user_edge == Edge::BOTH || events[i].edge == user_edge )
             {
-                event_callbacks[ch_info.gpio].erase( it );
+                events[count]         = events[i];
+                events[count].channel = state.event_channel;
+                count++;
             }
         }
-        catch( const std::exception &e )
+        noEvent = count;
+
+        if( noEvent == 0 )
         {
-            cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::remove_event_callback())" << endl;
-            _cleanup_all( );
-            terminate( );
+            return;
         }
-    }
+        state.events_detected += noEvent;
 
-    void remove_event_callback( int channel, const Callback &callback )
-    {
-        remove_event_callback( std::to_string( channel ), callback );
+        // The snapshot stays alive and unchanged while callbacks add or
+        // remove callbacks of their own line
+        auto callbacks =
+            std::atomic_load_explicit( &state.callbacks, memory_order_acquire );
+        if( callbacks == nullptr )
+        {
+            return;
+        }
+
+        EdgeEventSpan batch( events, noEvent );
+        for( const Callback &callback : *callbacks )
+        {
+            callback( batch );
+        }
     }
 
-    void add_event_detect( int channel, Edge edge, const Callback &callback,
-                           unsigned long bounce_time )
+    void callback_handler( LineRequest &line_request )
     {
-        try
+        EdgeEvent *events  = line_request.events.data( );
+        int        noEvent = line_request.request->read_edge_events(
+            events, line_request.events.size( ) );
+
+        if( noEvent == -1 )
         {
-            ChannelInfo ch_info =
-                _channel_to_info( std::to_string( channel ), true );
+            throw runtime_error( "Error Reading Events\n" );
+        }
 
-            // channel must be setup as input
-            Directions app_cfg = _app_channel_configuration( ch_info );
-            if( app_cfg != Directions::IN )
-            {
-                throw runtime_error(
-                    "You must setup() the GPIO channel as an input first" );
-            }
+        if( noEvent == 0 )
+        {
+            return;
+        }
+
+        if( line_request.lines.size( ) == 1 )
+        {
+            _dispatch_line( *line_request.lines.front( ), events, noEvent );
+            return;
+        }
 
-            // edge provided must be rising, falling or both
-            gpiod_line_edge gpiod_edge_val = GPIOD_LINE_EDGE_NONE;
-            if( edge != Edge::RISING && edge != Edge::FALLING &&
-                edge != Edge::BOTH )
+        // Demultiplex by offset, in batches of the buffer size of each line.
+        // Callbacks may unwatch lines or request them again meanwhile.
+        for( LineState *line : line_request.lines )
+        {
+            if( !line->watched || line->events.empty( ) ||
+                line->line_request.get( ) != &line_request )
             {
-                throw invalid_argument(
-                    "argument 'edge' must be set to RISING, FALLING or BOTH" );
+                continue;
             }
-            else
+
+            EdgeEvent *line_events = line->events.data( );
+            int        capacity    = int( line->events.size( ) );
+            int        count       = 0;
+            for( int i = 0; i < noEvent; i++ )
             {
-                if( edge == Edge::RISING )
+                if( events[i].offset != line->offset )
                 {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_RISING;
+                    continue;
                 }
-                else if( edge == Edge::FALLING )
-                {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_FALLING;
-                }
-                else
+
+                line_events[count++] = events[i];
+                if( count == capacity )
                 {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_BOTH;
+                    _dispatch_line( *line, line_events, count );
+                    count = 0;
                 }
             }
 
-            int status = gpiod_line_settings_set_edge_detection(
-                channelLineSettings[ch_info.gpio], gpiod_edge_val );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "failed to configure edge on the requested line\n" );
-            }
-
-            gpiod_line_settings_set_debounce_period_us(
-                channelLineSettings[ch_info.gpio],
-                TIME_MS_TO_US( bounce_time ) );
-
-            status = gpiod_line_config_add_line_settings(
-                channelLineConfig[ch_info.gpio], &ch_info.gpio, 1,
-                channelLineSettings[ch_info.gpio] );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "failed to configure the GPIO line for event\n" );
-            }
-
-            status = gpiod_line_request_reconfigure_lines(
-                channelLineRequest[ch_info.gpio],
-                channelLineConfig[ch_info.gpio] );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "Lines could not be reconfigured for edge events\n" );
-            }
-
-            // Execute
-            if( callback != nullptr )
-            {
-                add_event_callback( channel, callback );
-            }
-
-            if( event_buffer == NULL )
-            {
-                event_buffer = gpiod_edge_event_buffer_new( MAX_EVENTS );
-                channelEventBuffer[ch_info.gpio] = event_buffer;
-            }
-
-            if( event_buffer == NULL )
+            if( count != 0 )
             {
-                throw runtime_error( "Create Buffer Error Occured\n" );
+                _dispatch_line( *line, line_events, count );
             }
-
-            start_thread( channel );
-        }
-        catch( exception &e )
-        {
-            cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::add_event_detect())" << endl;
-            _cleanup_all( );
-            terminate( );
         }
     }
 
-    void remove_event_detect( const std::string &channel )
-    {
-        ChannelInfo ch_info = _channel_to_info( channel, true );
-        event_callbacks[ch_info.gpio].clear( );
-    }
-
-    void remove_event_detect( int channel )
-    {
-        remove_event_detect( std::to_string( channel ) );
-    }
-
-    int wait_for_edge( const std::string &channel, Edge edge,
-                       unsigned long bounce_time, int64_t timeout )
-    {
-        return wait_for_edge( std::atoi( channel.data( ) ), edge, bounce_time,
-                              timeout );
-    }
-
-    int wait_for_edge( int channel, Edge edge, unsigned long bounce_time,
-                       int64_t timeout )
+    void mirror_input( const std::string &channel, bool enable )
     {
         try
         {
-            std::lock_guard<std::recursive_mutex> mutex_lock( _epmutex );
+            const ChannelInfo &ch_info = _channel_to_info( channel, true );
+            LineState         &state   = _line_state( ch_info );
 
-            ChannelInfo                           ch_info =
-                _channel_to_info( std::to_string( channel ), true );
+            lock_guard<recursive_mutex> lock( state.chip_lock );
 
             // channel must be setup as input
-            Directions app_cfg = _app_channel_configuration( ch_info );
-            if( app_cfg != Directions::IN )
+            if( state.direction != Directions::IN )
             {
                 throw runtime_error(
                     "You must setup() the GPIO channel as an input first" );
             }
 
-            // edge provided must be rising, falling or both
-            gpiod_line_edge gpiod_edge_val = GPIOD_LINE_EDGE_NONE;
-            if( edge != Edge::RISING && edge != Edge::FALLING &&
-                edge != Edge::BOTH )
+            if( enable == state.mirror.enabled )
             {
-                throw invalid_argument(
-                    "argument 'edge' must be set to RISING, FALLING or BOTH" );
+                return;
             }
-            else
+
+            EventEngine &engine = EventEngine::get_instance( );
+
+            if( enable )
             {
-                if( edge == Edge::RISING )
+                if( state.line_request->waiter != nullptr )
                 {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_RISING;
+                    throw runtime_error(
+                        "Can't mirror a line waited on by wait_for_edge()" );
                 }
-                else if( edge == Edge::FALLING )
+
+                if( state.events.empty( ) )
                 {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_FALLING;
+                    state.events.resize( MAX_EVENTS );
+                    _size_request_events( *state.line_request );
                 }
-                else
+
+                state.config.edge = Edge::BOTH;
+                if( _apply_line_settings( state ) == -1 )
                 {
-                    gpiod_edge_val = GPIOD_LINE_EDGE_BOTH;
+                    throw runtime_error(
+                        "Lines could not be reconfigured for edge events\n" );
                 }
-            }
-
-            int status = gpiod_line_settings_set_edge_detection(
-                channelLineSettings[ch_info.gpio], gpiod_edge_val );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "failed to configure edge on the requested line\n" );
-            }
-
-            gpiod_line_settings_set_debounce_period_us(
-                channelLineSettings[ch_info.gpio],
-                TIME_MS_TO_US( bounce_time ) );
-
-            status = gpiod_line_config_add_line_settings(
-                channelLineConfig[ch_info.gpio], &ch_info.gpio, 1,
-                channelLineSettings[ch_info.gpio] );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "failed to configure the GPIO line for event\n" );
-            }
-
-            status = gpiod_line_request_reconfigure_lines(
-                channelLineRequest[ch_info.gpio],
-                channelLineConfig[ch_info.gpio] );
-            if( status == -1 )
-            {
-                _cleanup_gpiod( );
-                throw runtime_error(
-                    "Lines could not be reconfigured for edge events\n" );
-            }
-
-            // Execute
-            int no_events;
-            if( event_buffer == NULL )
-            {
-                event_buffer = gpiod_edge_event_buffer_new( MAX_EVENTS );
-            }
-
-            if( event_buffer == NULL )
-            {
-                throw runtime_error( "Create Buffer Error Occured\n" );
-            }
-
-            channelEventBuffer[ch_info.gpio] = event_buffer;
-
-            status = gpiod_line_request_wait_edge_events(
-                channelLineRequest[ch_info.gpio], TIME_MS_TO_NS( timeout ) );
-            end_wait_event = true;
-
-            if( status == -1 && end_wait_event != true )
-            {
-                throw runtime_error( "Wait Event Error Occured\n" );
-            }
-            else if( status == 0 )
-            {
-                return status;
-            }
-            else if( status == 1 )
-            {
-                no_events = gpiod_line_request_read_edge_events(
-                    channelLineRequest[ch_info.gpio],
-                    channelEventBuffer[ch_info.gpio], MAX_EVENTS );
 
-                std::cout << "Events Pending: " << no_events << "\n";
-                return status;
+                engine.mirror( state );
             }
             else
             {
-                return 0;
+                state.mirror.enabled = false;
+                if( state.user_edge == Edge::NONE )
+                {
+                    engine.unwatch( state );
+                }
+
+                state.config.edge = state.user_edge;
+                if( _apply_line_settings( state ) == -1 )
+                {
+                    throw runtime_error(
+                        "Lines could not be reconfigured for edge events\n" );
+                }
             }
         }
         catch( exception &e )
         {
             cerr << "[Exception] " << e.what( )
-                 << " (caught from: GPIO::wait_for_edge())" << endl;
+                 << " (caught from: GPIO::mirror_input())" << endl;
             _cleanup_all( );
             terminate( );
         }
     }
 
-    void start_thread( int channel )
+    void mirror_input( int channel, bool enable )
     {
-        _run_loop     = true;
-        event_handler = new std::thread( callback_handler, channel );
-        event_handler->detach( );
+        mirror_input( std::to_string( channel ), enable );
     }
 
-    void callback_handler( int channel )
+    InputMirrorStatus input_mirror_status( const std::string &channel )
     {
-
-        ChannelInfo ch_info =
-            _channel_to_info( std::to_string( channel ), true );
-        while( _run_loop )
+        try
         {
-            int noEvent = gpiod_line_request_read_edge_events(
-                channelLineRequest[ch_info.gpio],
-                channelEventBuffer[ch_info.gpio], MAX_EVENTS );
+            const ChannelInfo &ch_info = _channel_to_info( channel, true );
+            LineState         &state   = _line_state( ch_info );
 
-            if( noEvent == -1 )
-            {
-                throw runtime_error( "Error Reading Events\n" );
-            }
-            else
+            // The event thread applies the edges it reads under the chip
+            // lock, so edges still pending in the request aren't in value
+            lock_guard<recursive_mutex> lock( state.chip_lock );
+
+            InputMirrorStatus  status  = state.mirror.status( );
+            if( !status.stale && state.request != nullptr )
             {
-                for( int i = 0; i < noEvent; i++ )
-                {
-                    for( auto cb : event_callbacks[ch_info.gpio] )
-                    {
-                        cb( channel );
-                    }
-                }
+                status.stale = state.request->wait_edge_events( 0 ) == 1;
             }
+            status.overflowed = state.mirror.overflowed.exchange( false );
+            return status;
+        }
+        catch( exception &e )
+        {
+            cerr << "[Exception] " << e.what( )
+                 << " (caught from: GPIO::input_mirror_status())" << endl;
+            terminate( );
         }
     }
 
-    void event_cleanup( unsigned int channel )
+    InputMirrorStatus input_mirror_status( int channel )
     {
-        stop_thread( );
-        event_callbacks[channel].clear( );
+        return input_mirror_status( std::to_string( channel ) );
     }
 
-    void stop_thread( )
+    void event_cleanup( unsigned int channel )
     {
-        _run_loop     = false;
-        event_handler = nullptr;
+        for( auto &_pair : line_states )
+        {
+            if( _pair.second.offset == channel )
+            {
+                _cleanup_events( _pair.second );
+            }
+        }
     }
 
     //=============================== PWM =================================
@@ -1131,8 +2687,7 @@ namespace GPIO
     {
         try
         {
-            if( global._pwm_channels.find( to_string( channel ) ) !=
-                global._pwm_channels.end( ) )
+            if( _is_pwm_channel( to_string( channel ) ) )
             {
                 throw runtime_error( "Channel " + to_string( channel ) +
                                      " already running as PWM." );
@@ -1156,7 +2711,7 @@ namespace GPIO
         ChannelInfo ch_info =
             _channel_to_info( to_string( channel ), false, false );
 
-        if( !is_None( ch_info.pwm_chip_dir ) )
+        if( !is_None( ch_info.pwm_chip_dir( ) ) )
         {
             pImpl = new GpioPwmIfHw( channel, frequency_hz );
         }
@@ -1186,6 +2741,7 @@ namespace GPIO
             }
 
             pImpl->_reconfigure( frequency_hz, 0.0 );
+            lock_guard<mutex> lock( global._config_lock );
             global._channel_configuration[to_string( channel )] = GPIO::OUT;
             global._pwm_channels[to_string( channel )]          = true;
         }
@@ -1201,7 +2757,7 @@ namespace GPIO
 
     PWM::~PWM( )
     {
-        if( !is_in( pImpl->m_ch_info.channel, global._channel_configuration ) )
+        if( _app_channel_configuration( pImpl->m_ch_info ) == UNKNOWN )
         {
             /*
             The user probably ran cleanup() on the channel already, so avoid
@@ -1212,8 +2768,13 @@ namespace GPIO
         try
         {
             stop( );
+
+            lock_guard<mutex> lock( global._config_lock );
             global._channel_configuration.erase( pImpl->m_ch_info.channel );
             global._pwm_channels.erase( pImpl->m_ch_info.channel );
+
+            // Like the channel configuration, the line is no longer set up
+            _line_state( pImpl->m_ch_info ).direction = UNKNOWN;
         }
         catch( ... )
         {
@@ -1306,6 +2867,21 @@ namespace GPIO
         }
     }
 
+    PwmStats PWM::GetStats( ) const
+    {
+        return pImpl->stats( );
+    }
+
+    void PWM::ResetStats( )
+    {
+        pImpl->reset_stats( );
+    }
+
+    void set_pwm_thread_options( const PwmThreadOptions &options )
+    {
+        GpioPwmIfSw::set_thread_options( options );
+    }
+
     /*
     Function used to cleanup  pwm channels at the end of the program.
     If no channel is provided, all channels are cleaned
@@ -1333,7 +2909,7 @@ namespace GPIO
             }
 
             ChannelInfo ch_info = _channel_to_info( channel );
-            if( is_in( ch_info.channel, global._channel_configuration ) )
+            if( _app_channel_configuration( ch_info ) != UNKNOWN )
             {
                 _cleanup_one( ch_info );
             }
@@ -1357,31 +2933,72 @@ namespace GPIO
     template void setup<int>( const std::initializer_list<int> &channels,
                               Directions direction, int initial );
     template void output<int>( const std::initializer_list<int> &channels,
-                               int                               value );
+                               int value, bool force );
     template void output<int>( const std::initializer_list<int> &channels,
-                               const std::initializer_list<int> &values );
+                               const std::initializer_list<int> &values,
+                               bool                              force );
+    template void toggle<int>( const std::initializer_list<int> &channels );
 
     template void setup<string>( const std::initializer_list<string> &channels,
                                  Directions direction, int initial );
     template void output<string>( const std::initializer_list<string> &channels,
-                                  int                                  value );
+                                  int value, bool force );
     template void output<string>( const std::initializer_list<string> &channels,
-                                  const std::initializer_list<int>    &values );
+                                  const std::initializer_list<int>    &values,
+                                  bool                                 force );
+    template void toggle<string>(
+        const std::initializer_list<string> &channels );
+
+    template std::vector<EdgeEvent>
+    wait_for_edges<int>( const std::initializer_list<int> &channels, Edge edge,
+                         unsigned long bounce_time, int64_t timeout );
+    template std::vector<EdgeEvent>
+    wait_for_edges<int>( const std::vector<int> &channels, Edge edge,
+                         unsigned long bounce_time, int64_t timeout );
+    template void
+    wait_for_edges<int>( const std::vector<int> &channels, Edge edge,
+                         std::vector<EdgeEvent> &events,
+                         unsigned long bounce_time, int64_t timeout );
+    template std::vector<EdgeEvent>
+    wait_for_edges<string>( const std::initializer_list<string> &channels,
+                            Edge edge, unsigned long bounce_time,
+                            int64_t timeout );
+    template std::vector<EdgeEvent>
+    wait_for_edges<string>( const std::vector<string> &channels, Edge edge,
+                            unsigned long bounce_time, int64_t timeout );
+    template void
+    wait_for_edges<string>( const std::vector<string> &channels, Edge edge,
+                            std::vector<EdgeEvent> &events,
+                            unsigned long bounce_time, int64_t timeout );
 
     //======================================= CALLBACK
     //==============================================
 
     void Callback::operator( )( int input ) const
     {
-        if( function != nullptr )
+        EdgeEvent event{ };
+        event.edge    = Edge::UNKNOWN;
+        event.channel = input;
+
+        ( *this )( EdgeEventSpan( &event, 1 ) );
+    }
+
+    void Callback::operator( )( const EdgeEventSpan &events ) const
+    {
+        if( ops != nullptr )
         {
-            function( input );
+            ops->invoke( storage, events );
         }
     }
 
     bool operator==( const Callback &A, const Callback &B )
     {
-        return A.comparer( A.function, B.function );
+        if( A.ops != B.ops )
+        {
+            return false;
+        }
+
+        return A.ops == nullptr || A.ops->equal( A.storage, B.storage );
     }
 
     bool operator!=( const Callback &A, const Callback &B )
@@ -0,0 +1,79 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+// Standard headers
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Local headers
+#include "gpio_backend.h"
+#include "gpio_backend_gpiod.h"
+#include "gpio_backend_sim.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    static GpioBackend *_make_backend( )
+    {
+        const char *env  = getenv( "TI_GPIO_BACKEND" );
+        string      name = env != nullptr ? env : "gpiod";
+
+        if( name == "gpiod" )
+        {
+            return new GpioBackendGpiod( );
+        }
+        else if( name == "sim" )
+        {
+            return new GpioBackendSim( );
+        }
+
+        throw runtime_error( "Unknown GPIO backend: " + name );
+    }
+
+    const string &fs_root( )
+    {
+        static const string root = [] {
+            const char *env = getenv( "TI_GPIO_ROOT" );
+            string      dir = env != nullptr ? env : "";
+
+            // "/" and "/root/" stand for the same tree as "" and "/root"
+            while( !dir.empty( ) && dir.back( ) == '/' )
+            {
+                dir.pop_back( );
+            }
+            return dir;
+        }( );
+        return root;
+    }
+
+    GpioBackend &_backend( )
+    {
+        // Never freed: line requests held by static objects may be released
+        // after the other statics are destroyed
+        static GpioBackend *backend = _make_backend( );
+        return *backend;
+    }
+
+} // namespace GPIO
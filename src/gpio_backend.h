@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_BACKEND_H
+#define GPIO_BACKEND_H
+
+// Standard headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+
+namespace GPIO
+{
+    // Configuration of one line of a line request
+    struct LineConfig
+    {
+        unsigned int  offset{ 0 };
+        Directions    direction{ Directions::IN };
+        int           value{ LOW }; // output value
+        Edge          edge{ Edge::NONE };
+        unsigned long debounce_us{ 0 };
+    };
+
+    /*
+    Lines of a gpiochip requested together. Released when destroyed.
+    Values are LOW or HIGH, functions returning int return -1 on error with
+    errno set.
+    */
+    class BackendRequest
+    {
+      public:
+        virtual ~BackendRequest( ) = default;
+
+        // Apply the configuration of every line of the request
+        virtual int reconfigure( const std::vector<LineConfig> &lines )  = 0;
+
+        virtual int get_value( unsigned int offset )                     = 0;
+        virtual int set_value( unsigned int offset, int value )          = 0;
+        virtual int set_values( size_t count, const unsigned int *offsets,
+                                const int *values )                      = 0;
+
+        // File descriptor readable while edge events are pending
+        virtual int fd( )                                                = 0;
+
+        // 1 if edge events are pending, 0 on timeout (negative waits forever)
+        virtual int wait_edge_events( int64_t timeout_ns )               = 0;
+
+        // Read up to max_events pending events, oldest first. channel is
+        // left for the caller to fill.
+        virtual int read_edge_events( EdgeEvent *events,
+                                      size_t     max_events )            = 0;
+    };
+
+    /*
+    Access to the GPIO controllers. GpioBackendGpiod goes to the kernel
+    through libgpiod, GpioBackendSim simulates the gpiochips in memory so
+    the library runs on machines without GPIOs.
+    The backend is selected once, by the TI_GPIO_BACKEND environment
+    variable: "gpiod" (the default) or "sim".
+    */
+    class GpioBackend
+    {
+      public:
+        virtual ~GpioBackend( ) = default;
+
+        // Request lines of gpiochip chip_gpio, throws system_error on failure.
+        // The kernel queues up to event_buffer_size edge events of the
+        // request, 0 keeps its default of 16 per line.
+        virtual std::unique_ptr<BackendRequest>
+        request_lines( int                            chip_gpio,
+                       const std::vector<LineConfig> &lines,
+                       size_t event_buffer_size = 0 ) = 0;
+
+        // Direction of a line as configured by anyone, UNKNOWN if unknown
+        virtual Directions line_direction( int          chip_gpio,
+                                           unsigned int offset ) = 0;
+
+        // Close the handles of the gpiochips, requests stay usable
+        virtual void       close_chips( )                        = 0;
+
+        // Model name to use instead of the device tree, empty if none
+        virtual std::string board_model( ) { return ""; }
+
+        // Whether hardware PWMs are looked up in sysfs
+        virtual bool        sysfs_pwm( ) { return true; }
+    };
+
+    GpioBackend       &_backend( );
+
+    /*
+    Directory standing for / when the library reaches /proc, /sys and /dev,
+    from the TI_GPIO_ROOT environment variable, empty to use the real ones.
+    It is read once, before the board is discovered at static
+    initialization, so it can't be changed once the program runs.
+    */
+    const std::string &fs_root( );
+
+} // namespace GPIO
+
+#endif // GPIO_BACKEND_H
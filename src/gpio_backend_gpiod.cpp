@@ -0,0 +1,361 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+// Standard headers
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_backend_gpiod.h"
+#include "gpio_common.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    // Line request of libgpiod, with its edge event buffer
+    class GpiodRequest : public BackendRequest
+    {
+      public:
+        explicit GpiodRequest( gpiod_line_request *request )
+            : m_request( request )
+        {
+        }
+
+        ~GpiodRequest( ) override
+        {
+            if( m_buffer != NULL )
+            {
+                gpiod_edge_event_buffer_free( m_buffer );
+            }
+            gpiod_line_request_release( m_request );
+        }
+
+        int reconfigure( const vector<LineConfig> &lines ) override;
+        int get_value( unsigned int offset ) override;
+        int set_value( unsigned int offset, int value ) override;
+        int set_values( size_t count, const unsigned int *offsets,
+                        const int *values ) override;
+        int fd( ) override;
+        int wait_edge_events( int64_t timeout_ns ) override;
+        int read_edge_events( EdgeEvent *events, size_t max_events ) override;
+
+      private:
+        gpiod_line_request      *m_request;
+        gpiod_edge_event_buffer *m_buffer{ NULL }; // created on first read
+    };
+
+    static gpiod_line_value _gpiod_value( int value )
+    {
+        return value == HIGH ? GPIOD_LINE_VALUE_ACTIVE
+                             : GPIOD_LINE_VALUE_INACTIVE;
+    }
+
+    static gpiod_line_edge _gpiod_edge( Edge edge )
+    {
+        if( edge == Edge::RISING )
+        {
+            return GPIOD_LINE_EDGE_RISING;
+        }
+        else if( edge == Edge::FALLING )
+        {
+            return GPIOD_LINE_EDGE_FALLING;
+        }
+        else if( edge == Edge::BOTH )
+        {
+            return GPIOD_LINE_EDGE_BOTH;
+        }
+        return GPIOD_LINE_EDGE_NONE;
+    }
+
+    // Build the gpiod configuration of lines, NULL on failure
+    static gpiod_line_config *_gpiod_config( const vector<LineConfig> &lines )
+    {
+        gpiod_line_config   *config   = gpiod_line_config_new( );
+        gpiod_line_settings *settings = gpiod_line_settings_new( );
+
+        bool                 ok       = config != NULL && settings != NULL;
+
+        for( size_t i = 0; ok && i < lines.size( ); i++ )
+        {
+            const LineConfig &line = lines[i];
+
+            gpiod_line_settings_reset( settings );
+
+            if( line.direction == OUT )
+            {
+                ok = gpiod_line_settings_set_direction(
+                         settings, GPIOD_LINE_DIRECTION_OUTPUT ) == 0 &&
+                     gpiod_line_settings_set_output_value(
+                         settings, _gpiod_value( line.value ) ) == 0;
+            }
+            else
+            {
+                ok = gpiod_line_settings_set_direction(
+                         settings, GPIOD_LINE_DIRECTION_INPUT ) == 0 &&
+                     gpiod_line_settings_set_edge_detection(
+                         settings, _gpiod_edge( line.edge ) ) == 0;
+                gpiod_line_settings_set_debounce_period_us( settings,
+                                                            line.debounce_us );
+            }
+
+            ok = ok && gpiod_line_config_add_line_settings(
+                           config, &line.offset, 1, settings ) == 0;
+        }
+
+        if( settings != NULL )
+        {
+            gpiod_line_settings_free( settings );
+        }
+
+        if( !ok && config != NULL )
+        {
+            gpiod_line_config_free( config );
+            config = NULL;
+        }
+
+        return config;
+    }
+
+    int GpiodRequest::reconfigure( const vector<LineConfig> &lines )
+    {
+        gpiod_line_config *config = _gpiod_config( lines );
+        if( config == NULL )
+        {
+            return -1;
+        }
+
+        int status = gpiod_line_request_reconfigure_lines( m_request, config );
+        gpiod_line_config_free( config );
+
+        return status;
+    }
+
+    int GpiodRequest::get_value( unsigned int offset )
+    {
+        return gpiod_line_request_get_value( m_request, offset );
+    }
+
+    int GpiodRequest::set_value( unsigned int offset, int value )
+    {
+        return gpiod_line_request_set_value( m_request, offset,
+                                             _gpiod_value( value ) );
+    }
+
+    int GpiodRequest::set_values( size_t count, const unsigned int *offsets,
+                                  const int *values )
+    {
+        // No allocation for the usual number of lines of a request
+        gpiod_line_value         stack_values[64];
+        vector<gpiod_line_value> heap_values{ };
+
+        gpiod_line_value        *gpiod_values = stack_values;
+        if( count > 64 )
+        {
+            heap_values.resize( count );
+            gpiod_values = heap_values.data( );
+        }
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            gpiod_values[i] = _gpiod_value( values[i] );
+        }
+
+        return gpiod_line_request_set_values_subset( m_request, count, offsets,
+                                                     gpiod_values );
+    }
+
+    int GpiodRequest::fd( )
+    {
+        return gpiod_line_request_get_fd( m_request );
+    }
+
+    int GpiodRequest::wait_edge_events( int64_t timeout_ns )
+    {
+        return gpiod_line_request_wait_edge_events( m_request, timeout_ns );
+    }
+
+    int GpiodRequest::read_edge_events( EdgeEvent *events, size_t max_events )
+    {
+        if( m_buffer != NULL &&
+            gpiod_edge_event_buffer_get_capacity( m_buffer ) < max_events )
+        {
+            gpiod_edge_event_buffer_free( m_buffer );
+            m_buffer = NULL;
+        }
+
+        if( m_buffer == NULL )
+        {
+            m_buffer = gpiod_edge_event_buffer_new( max_events );
+            if( m_buffer == NULL )
+            {
+                return -1;
+            }
+        }
+
+        int count = gpiod_line_request_read_edge_events( m_request, m_buffer,
+                                                         max_events );
+
+        for( int i = 0; i < count; i++ )
+        {
+            gpiod_edge_event *event =
+                gpiod_edge_event_buffer_get_event( m_buffer, i );
+
+            events[i].timestamp_ns = gpiod_edge_event_get_timestamp_ns( event );
+            events[i].edge = gpiod_edge_event_get_event_type( event ) ==
+                                     GPIOD_EDGE_EVENT_RISING_EDGE
+                                 ? Edge::RISING
+                                 : Edge::FALLING;
+            events[i].line_seqno   = gpiod_edge_event_get_line_seqno( event );
+            events[i].global_seqno = gpiod_edge_event_get_global_seqno( event );
+            events[i].offset       = gpiod_edge_event_get_line_offset( event );
+        }
+
+        return count;
+    }
+
+    GpioBackendGpiod::~GpioBackendGpiod( )
+    {
+        close_chips( );
+    }
+
+    // Return the handle of gpiochip chip_gpio, opening it on first use
+    gpiod_chip *GpioBackendGpiod::open_chip( int chip_gpio )
+    {
+        auto it = m_chips.find( chip_gpio );
+        if( it != m_chips.end( ) )
+        {
+            return it->second;
+        }
+
+        std::string gpiochipX =
+            fs_root( ) + "/dev/gpiochip" + to_string( chip_gpio );
+        gpiod_chip *chip      = gpiod_chip_open( gpiochipX.c_str( ) );
+        if( chip == NULL )
+        {
+            throw system_error( errno, generic_category( ),
+                                "GPIO open chip failed" );
+        }
+
+        m_chips[chip_gpio] = chip;
+        return chip;
+    }
+
+    unique_ptr<BackendRequest>
+    GpioBackendGpiod::request_lines( int                       chip_gpio,
+                                     const vector<LineConfig> &lines,
+                                     size_t event_buffer_size )
+    {
+        lock_guard<mutex>     lock( m_lock );
+
+        gpiod_chip           *chip       = open_chip( chip_gpio );
+        gpiod_request_config *req_config = NULL;
+        if( event_buffer_size != 0 )
+        {
+            req_config = gpiod_request_config_new( );
+            if( req_config == NULL )
+            {
+                throw system_error( errno, generic_category( ),
+                                    "failed to configure the GPIO request" );
+            }
+            gpiod_request_config_set_event_buffer_size( req_config,
+                                                        event_buffer_size );
+        }
+
+        gpiod_line_config *config = _gpiod_config( lines );
+        if( config == NULL )
+        {
+            int error = errno;
+            gpiod_request_config_free( req_config );
+            throw system_error( error, generic_category( ),
+                                "failed to configure the GPIO lines" );
+        }
+
+        gpiod_line_request *request =
+            gpiod_chip_request_lines( chip, req_config, config );
+        int error = errno;
+        gpiod_line_config_free( config );
+        gpiod_request_config_free( req_config );
+
+        if( request == NULL )
+        {
+            throw system_error( error, generic_category( ),
+                                "failed to get the requested GPIO line" );
+        }
+
+        return make_unique<GpiodRequest>( request );
+    }
+
+    Directions GpioBackendGpiod::line_direction( int          chip_gpio,
+                                                 unsigned int offset )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        auto              it = m_chips.find( chip_gpio );
+        if( it == m_chips.end( ) )
+        {
+            return UNKNOWN;
+        }
+
+        gpiod_line_info *line_info =
+            gpiod_chip_get_line_info( it->second, offset );
+        if( line_info == NULL )
+        {
+            return UNKNOWN;
+        }
+
+        gpiod_line_direction direction =
+            gpiod_line_info_get_direction( line_info );
+        gpiod_line_info_free( line_info );
+
+        if( direction == GPIOD_LINE_DIRECTION_INPUT )
+        {
+            return IN;
+        }
+        else if( direction == GPIOD_LINE_DIRECTION_OUTPUT )
+        {
+            return OUT;
+        }
+        return UNKNOWN;
+    }
+
+    /*
+    Close every gpiochip opened by this process. Line requests hold their own
+    file descriptor, so lines already requested stay usable.
+    */
+    void GpioBackendGpiod::close_chips( )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        for( auto &_pair : m_chips )
+        {
+            gpiod_chip_close( _pair.second );
+        }
+        m_chips.clear( );
+    }
+
+} // namespace GPIO
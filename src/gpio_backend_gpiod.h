@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_BACKEND_GPIOD_H
+#define GPIO_BACKEND_GPIOD_H
+
+// Standard headers
+#include <map>
+#include <mutex>
+
+// Local headers
+#include "gpio_backend.h"
+
+namespace GPIO
+{
+    // Backend using the GPIO character devices through libgpiod
+    class GpioBackendGpiod : public GpioBackend
+    {
+      public:
+        GpioBackendGpiod( ) = default;
+        ~GpioBackendGpiod( ) override;
+
+        std::unique_ptr<BackendRequest>
+        request_lines( int                            chip_gpio,
+                       const std::vector<LineConfig> &lines,
+                       size_t event_buffer_size = 0 ) override;
+
+        Directions line_direction( int          chip_gpio,
+                                   unsigned int offset ) override;
+
+        void       close_chips( ) override;
+
+      private:
+        gpiod_chip *open_chip( int chip_gpio );
+
+      private:
+        // Keyed by gpiochip number, each chip is opened once and shared by
+        // all of its lines until cleanup()
+        std::map<int, gpiod_chip *> m_chips;
+        std::mutex                  m_lock;
+    };
+
+} // namespace GPIO
+
+#endif // GPIO_BACKEND_GPIOD_H
@@ -0,0 +1,571 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+// Standard headers
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_backend_sim.h"
+#include "gpio_common.h"
+
+// Edge events kept per line before the oldest is dropped, as the kernel does
+#define SIM_EVENTS_PER_LINE 16
+
+// Largest event buffer of a request accepted by the kernel
+#define SIM_MAX_EVENT_BUFFER ( 64 * SIM_EVENTS_PER_LINE )
+
+using namespace std;
+
+namespace GPIO
+{
+    static GpioBackendSim *sim_instance = nullptr;
+
+    static uint64_t        _monotonic_ns( )
+    {
+        timespec ts{ };
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return uint64_t( ts.tv_sec ) * 1000000000ull + ts.tv_nsec;
+    }
+
+    // Busy wait, sleeping is too coarse for the latency of a system call
+    static void _spin_for( uint64_t duration_ns )
+    {
+        if( duration_ns == 0 )
+        {
+            return;
+        }
+
+        uint64_t end = _monotonic_ns( ) + duration_ns;
+        while( _monotonic_ns( ) < end )
+        {
+        }
+    }
+
+    /*
+    Request of simulated lines. Its edge events are kept in a ring buffer
+    allocated with the request and its fd is an eventfd, readable while
+    events are pending, so it can be polled like a gpiod request.
+    */
+    class SimRequest : public BackendRequest
+    {
+      public:
+        SimRequest( GpioBackendSim &backend, int chip_gpio,
+                    const vector<LineConfig> &lines, size_t event_buffer_size )
+            : m_backend( backend ), m_chip_gpio( chip_gpio ),
+              m_events( event_buffer_size != 0
+                            ? event_buffer_size
+                            : lines.size( ) * SIM_EVENTS_PER_LINE )
+        {
+            m_fd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+            if( m_fd == -1 )
+            {
+                throw runtime_error( "Could not create the event fd: " +
+                                     string( strerror( errno ) ) );
+            }
+
+            for( const auto &config : lines )
+            {
+                m_offsets.push_back( config.offset );
+            }
+        }
+
+        ~SimRequest( ) override
+        {
+            {
+                lock_guard<mutex> lock( m_backend.m_lock );
+                for( unsigned int offset : m_offsets )
+                {
+                    auto &line = m_backend.line( m_chip_gpio, offset );
+                    if( line.owner == this )
+                    {
+                        line.owner = nullptr;
+                        line.edge  = Edge::NONE;
+                    }
+                }
+            }
+            close( m_fd );
+        }
+
+        // Called with the backend lock held
+        void apply( const vector<LineConfig> &lines )
+        {
+            uint64_t now = _monotonic_ns( );
+
+            for( const auto &config : lines )
+            {
+                auto &line = m_backend.line( m_chip_gpio, config.offset );
+                if( line.owner != this )
+                {
+                    // Sequence numbers start again with each request
+                    line.line_seqno = 0;
+                }
+                line.owner     = this;
+                line.direction = config.direction;
+                if( config.direction == OUT )
+                {
+                    m_backend.write( line, config.value, now );
+                    line.edge = Edge::NONE;
+                }
+                else
+                {
+                    line.edge = config.edge;
+                }
+            }
+        }
+
+        // Called with the backend lock held
+        void push( const EdgeEvent &event )
+        {
+            // Drop the oldest event when full, the fd is already readable
+            if( m_count == m_events.size( ) )
+            {
+                m_events[m_head] = event;
+                m_head           = ( m_head + 1 ) % m_events.size( );
+                return;
+            }
+
+            m_events[( m_head + m_count ) % m_events.size( )] = event;
+            m_count++;
+
+            uint64_t value = 1;
+            if( write( m_fd, &value, sizeof( value ) ) == -1 )
+            {
+                // The counter can't overflow, one increment per event
+            }
+        }
+
+        int reconfigure( const vector<LineConfig> &lines ) override
+        {
+            unique_lock<mutex> lock( m_backend.m_lock );
+            uint64_t           latency_ns = m_backend.m_latency.request_ns;
+
+            for( const auto &config : lines )
+            {
+                if( !owns( config.offset ) )
+                {
+                    errno = EPERM;
+                    return -1;
+                }
+            }
+
+            apply( lines );
+
+            lock.unlock( );
+            _spin_for( latency_ns );
+            return 0;
+        }
+
+        int get_value( unsigned int offset ) override
+        {
+            unique_lock<mutex> lock( m_backend.m_lock );
+            uint64_t           latency_ns = m_backend.m_latency.get_ns;
+
+            if( !owns( offset ) )
+            {
+                errno = EPERM;
+                return -1;
+            }
+
+            auto &line  = m_backend.line( m_chip_gpio, offset );
+            int   value = line.direction == OUT ? line.output : line.input;
+
+            lock.unlock( );
+            _spin_for( latency_ns );
+            return value;
+        }
+
+        int set_value( unsigned int offset, int value ) override
+        {
+            return set_values( 1, &offset, &value );
+        }
+
+        int set_values( size_t count, const unsigned int *offsets,
+                        const int *values ) override
+        {
+            unique_lock<mutex> lock( m_backend.m_lock );
+            uint64_t           latency_ns = m_backend.m_latency.set_ns;
+
+            for( size_t i = 0; i < count; i++ )
+            {
+                if( !owns( offsets[i] ) ||
+                    m_backend.line( m_chip_gpio, offsets[i] ).direction != OUT )
+                {
+                    errno = EPERM;
+                    return -1;
+                }
+            }
+
+            uint64_t now = _monotonic_ns( );
+            for( size_t i = 0; i < count; i++ )
+            {
+                m_backend.write( m_backend.line( m_chip_gpio, offsets[i] ),
+                                 values[i], now );
+            }
+
+            lock.unlock( );
+            _spin_for( latency_ns );
+            return 0;
+        }
+
+        int fd( ) override { return m_fd; }
+
+        int wait_edge_events( int64_t timeout_ns ) override
+        {
+            pollfd pfd{ };
+            pfd.fd     = m_fd;
+            pfd.events = POLLIN;
+
+            int timeout_ms =
+                timeout_ns < 0 ? -1 : int( ( timeout_ns + 999999 ) / 1000000 );
+
+            int ret = poll( &pfd, 1, timeout_ms );
+            return ret > 0 ? 1 : ret;
+        }
+
+        int read_edge_events( EdgeEvent *events, size_t max_events ) override
+        {
+            unique_lock<mutex> lock( m_backend.m_lock );
+            uint64_t           latency_ns = m_backend.m_latency.read_events_ns;
+
+            size_t             count      = 0;
+            while( count < max_events && m_count > 0 )
+            {
+                events[count++] = m_events[m_head];
+                m_head          = ( m_head + 1 ) % m_events.size( );
+                m_count--;
+            }
+
+            // Not readable anymore once every event is consumed
+            if( m_count == 0 )
+            {
+                uint64_t value;
+                if( read( m_fd, &value, sizeof( value ) ) == -1 )
+                {
+                    // Already drained
+                }
+            }
+
+            lock.unlock( );
+            _spin_for( latency_ns );
+            return int( count );
+        }
+
+      private:
+        bool owns( unsigned int offset ) const
+        {
+            for( unsigned int o : m_offsets )
+            {
+                if( o == offset )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+      private:
+        GpioBackendSim       &m_backend;
+        const int             m_chip_gpio;
+        vector<unsigned int>  m_offsets;
+        int                   m_fd{ -1 };
+
+        // Ring buffer of pending events, guarded by the backend lock
+        vector<EdgeEvent>     m_events;
+        size_t                m_head{ 0 };
+        size_t                m_count{ 0 };
+    };
+
+    GpioBackendSim::GpioBackendSim( )
+    {
+        const char *model = getenv( "TI_GPIO_SIM_MODEL" );
+        m_model           = model != nullptr    ? model
+                            : fs_root( ).empty( ) ? "J721E_SK"
+                                                  : "";
+
+        sim_instance      = this;
+    }
+
+    GpioBackendSim *GpioBackendSim::get_instance( )
+    {
+        _backend( );
+        return sim_instance;
+    }
+
+    // Called with the lock held
+    GpioBackendSim::SimLine &GpioBackendSim::line( int          chip_gpio,
+                                                   unsigned int offset )
+    {
+        return m_lines[{ chip_gpio, offset }];
+    }
+
+    unique_ptr<BackendRequest>
+    GpioBackendSim::request_lines( int                       chip_gpio,
+                                   const vector<LineConfig> &lines,
+                                   size_t event_buffer_size )
+    {
+        if( event_buffer_size > SIM_MAX_EVENT_BUFFER )
+        {
+            throw system_error( EINVAL, generic_category( ),
+                                "failed to get the requested GPIO line" );
+        }
+
+        auto request = make_unique<SimRequest>( *this, chip_gpio, lines,
+                                                event_buffer_size );
+
+        unique_lock<mutex> lock( m_lock );
+        uint64_t           latency_ns = m_latency.request_ns;
+
+        for( const auto &config : lines )
+        {
+            if( line( chip_gpio, config.offset ).owner != nullptr )
+            {
+                throw system_error( EBUSY, generic_category( ),
+                                    "failed to get the requested GPIO line" );
+            }
+        }
+
+        request->apply( lines );
+
+        lock.unlock( );
+        _spin_for( latency_ns );
+        return request;
+    }
+
+    Directions GpioBackendSim::line_direction( int          chip_gpio,
+                                               unsigned int offset )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        auto              it = m_lines.find( { chip_gpio, offset } );
+        return it != m_lines.end( ) ? it->second.direction : UNKNOWN;
+    }
+
+    void GpioBackendSim::set_input( int chip_gpio, unsigned int offset,
+                                    int value )
+    {
+        lock_guard<mutex> lock( m_lock );
+        drive( chip_gpio, offset, value );
+    }
+
+    // Called with the lock held
+    void GpioBackendSim::drive( int chip_gpio, unsigned int offset, int value )
+    {
+        SimLine &sim_line = line( chip_gpio, offset );
+        if( sim_line.input == value )
+        {
+            return;
+        }
+        sim_line.input = value;
+
+        if( sim_line.owner == nullptr || sim_line.direction != IN )
+        {
+            return;
+        }
+
+        Edge edge = value == HIGH ? Edge::RISING : Edge::FALLING;
+        if( sim_line.edge != edge && sim_line.edge != Edge::BOTH )
+        {
+            return;
+        }
+
+        EdgeEvent event{ };
+        event.timestamp_ns = _monotonic_ns( );
+        event.edge         = edge;
+        event.line_seqno   = ++sim_line.line_seqno;
+        event.global_seqno = ++m_global_seqno;
+        event.offset       = offset;
+
+        sim_line.owner->push( event );
+    }
+
+    int GpioBackendSim::level( int chip_gpio, unsigned int offset )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        SimLine          &sim_line = line( chip_gpio, offset );
+        return sim_line.direction == OUT ? sim_line.output : sim_line.input;
+    }
+
+    // Called with the lock held
+    void GpioBackendSim::write( SimLine &sim_line, int value,
+                                uint64_t timestamp_ns )
+    {
+        sim_line.output = value;
+        if( sim_line.recording )
+        {
+            sim_line.recorded.push_back( { timestamp_ns, value } );
+        }
+    }
+
+    void GpioBackendSim::play( int chip_gpio, unsigned int offset,
+                               const vector<sim::WaveformStep> &steps,
+                               bool                             repeat )
+    {
+        uint64_t length_ns = 0;
+        for( const auto &step : steps )
+        {
+            length_ns += step.hold_ns;
+        }
+
+        if( repeat && length_ns == 0 )
+        {
+            throw invalid_argument( "A repeated waveform can't last 0 ns" );
+        }
+
+        lock_guard<mutex> lock( m_lock );
+
+        m_waveforms.erase(
+            remove_if( m_waveforms.begin( ), m_waveforms.end( ),
+                       [&]( const Waveform &w ) {
+                           return w.chip_gpio == chip_gpio &&
+                                  w.offset == offset;
+                       } ),
+            m_waveforms.end( ) );
+
+        if( steps.empty( ) )
+        {
+            m_idle_cv.notify_all( );
+            return;
+        }
+
+        m_waveforms.push_back(
+            { chip_gpio, offset, steps, repeat, 0, _monotonic_ns( ) } );
+
+        if( !m_player.joinable( ) )
+        {
+            m_player = thread( [this] { run_waveforms( ); } );
+        }
+        m_player_cv.notify_one( );
+    }
+
+    void GpioBackendSim::stop( int chip_gpio, unsigned int offset )
+    {
+        play( chip_gpio, offset, { }, false );
+    }
+
+    void GpioBackendSim::wait_waveforms( )
+    {
+        unique_lock<mutex> lock( m_lock );
+
+        m_idle_cv.wait( lock, [this] {
+            return all_of( m_waveforms.begin( ), m_waveforms.end( ),
+                           []( const Waveform &w ) { return w.repeat; } );
+        } );
+    }
+
+    /*
+    Apply the steps of the waveforms at their due time. Steps are timed from
+    the due time of the previous one rather than from when it was applied,
+    so a late wake up doesn't shift the rest of the waveform.
+    Runs until the process exits, the backend is never destroyed.
+    */
+    void GpioBackendSim::run_waveforms( )
+    {
+        unique_lock<mutex> lock( m_lock );
+
+        while( true )
+        {
+            if( m_waveforms.empty( ) )
+            {
+                m_player_cv.wait( lock );
+                continue;
+            }
+
+            auto next = min_element(
+                m_waveforms.begin( ), m_waveforms.end( ),
+                []( const Waveform &a, const Waveform &b ) {
+                    return a.due_ns < b.due_ns;
+                } );
+
+            uint64_t now = _monotonic_ns( );
+            if( next->due_ns > now )
+            {
+                // steady_clock is CLOCK_MONOTONIC on Linux
+                m_player_cv.wait_until(
+                    lock, chrono::steady_clock::time_point(
+                              chrono::nanoseconds( next->due_ns ) ) );
+                continue;
+            }
+
+            const sim::WaveformStep &step = next->steps[next->next];
+            drive( next->chip_gpio, next->offset, step.value );
+
+            next->due_ns += step.hold_ns;
+            next->next++;
+
+            if( next->next == next->steps.size( ) )
+            {
+                if( next->repeat )
+                {
+                    next->next = 0;
+                }
+                else
+                {
+                    m_waveforms.erase( next );
+                    m_idle_cv.notify_all( );
+                }
+            }
+        }
+    }
+
+    void GpioBackendSim::record( int chip_gpio, unsigned int offset,
+                                 size_t capacity )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        SimLine          &sim_line = line( chip_gpio, offset );
+        sim_line.recorded.clear( );
+        sim_line.recorded.reserve( capacity );
+        sim_line.recording = true;
+    }
+
+    vector<sim::OutputSample> GpioBackendSim::recorded( int          chip_gpio,
+                                                        unsigned int offset )
+    {
+        lock_guard<mutex> lock( m_lock );
+        return line( chip_gpio, offset ).recorded;
+    }
+
+    void GpioBackendSim::set_latency( const sim::Latency &latency )
+    {
+        lock_guard<mutex> lock( m_lock );
+        m_latency = latency;
+    }
+
+} // namespace GPIO
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_BACKEND_SIM_H
+#define GPIO_BACKEND_SIM_H
+
+// Standard headers
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Interface headers
+#include <GPIO_sim.h>
+
+// Local headers
+#include "gpio_backend.h"
+
+namespace GPIO
+{
+    class SimRequest;
+
+    /*
+    Backend simulating the gpiochips in memory, selected with
+    TI_GPIO_BACKEND=sim. Lines behave like the kernel ones: a line can be
+    requested by one request at a time, outputs keep the value written to
+    them and inputs report the level set with set_input(), queuing an edge
+    event when it changes on a line with edge detection.
+    Input waveforms are played by a thread of the backend, started by the
+    first play(). Every call of a request busy waits for the latency set for
+    its kind of call.
+    The board model comes from TI_GPIO_SIM_MODEL (J721E_SK by default) and
+    no hardware PWM is available. With TI_GPIO_ROOT set and no model given,
+    the board and its hardware PWMs are found in the tree under the root
+    instead, like on a board.
+    */
+    class GpioBackendSim : public GpioBackend
+    {
+      public:
+        GpioBackendSim( );
+
+        // The simulated backend, nullptr if another backend is in use
+        static GpioBackendSim *get_instance( );
+
+        std::unique_ptr<BackendRequest>
+        request_lines( int                            chip_gpio,
+                       const std::vector<LineConfig> &lines,
+                       size_t event_buffer_size = 0 ) override;
+
+        Directions  line_direction( int          chip_gpio,
+                                    unsigned int offset ) override;
+
+        void        close_chips( ) override {}
+
+        std::string board_model( ) override { return m_model; }
+
+        bool        sysfs_pwm( ) override { return m_model.empty( ); }
+
+        // Drive the level seen by an input line
+        void        set_input( int chip_gpio, unsigned int offset, int value );
+
+        // Level of a line, the value written to it for an output
+        int         level( int chip_gpio, unsigned int offset );
+
+        // Input waveforms, see GPIO::sim::play()
+        void play( int chip_gpio, unsigned int offset,
+                   const std::vector<sim::WaveformStep> &steps, bool repeat );
+        void stop( int chip_gpio, unsigned int offset );
+        void wait_waveforms( );
+
+        // Output recording, see GPIO::sim::record()
+        void record( int chip_gpio, unsigned int offset, size_t capacity );
+        std::vector<sim::OutputSample> recorded( int          chip_gpio,
+                                                 unsigned int offset );
+
+        void set_latency( const sim::Latency &latency );
+
+      private:
+        friend class SimRequest;
+
+        struct SimLine
+        {
+            Directions    direction{ Directions::UNKNOWN };
+            int           output{ LOW };
+            int           input{ LOW };
+            Edge          edge{ Edge::NONE };
+            unsigned long line_seqno{ 0 };
+            SimRequest   *owner{ nullptr };
+
+            // Written values, while recording
+            bool                           recording{ false };
+            std::vector<sim::OutputSample> recorded;
+        };
+
+        struct Waveform
+        {
+            int                            chip_gpio;
+            unsigned int                   offset;
+            std::vector<sim::WaveformStep> steps;
+            bool                           repeat;
+            size_t                         next;   // step to apply
+            uint64_t                       due_ns; // when to apply it
+        };
+
+        SimLine &line( int chip_gpio, unsigned int offset );
+
+        // Called with the lock held
+        void     drive( int chip_gpio, unsigned int offset, int value );
+        void     write( SimLine &sim_line, int value, uint64_t timestamp_ns );
+
+        void     run_waveforms( );
+
+      private:
+        std::map<std::pair<int, unsigned int>, SimLine> m_lines;
+        unsigned long                                   m_global_seqno{ 0 };
+        std::string                                     m_model;
+        sim::Latency                                    m_latency;
+
+        std::vector<Waveform>                           m_waveforms;
+        std::thread                                     m_player;
+        std::condition_variable                         m_player_cv;
+        std::condition_variable                         m_idle_cv;
+
+        std::mutex                                      m_lock;
+    };
+
+} // namespace GPIO
+
+#endif // GPIO_BACKEND_SIM_H
@@ -0,0 +1,220 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard headers
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+// Local headers
+#include "gpio_board_cache.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    /*
+    The file is the magic followed by length prefixed strings: compatible,
+    boot id, board file key, model, then the number of PWM chips found and
+    the name and directory of each. Lengths and the count are native 32 bit
+    integers, the file is only read on the machine that wrote it.
+    */
+    static constexpr char   MAGIC[]        = "TIGPIOB3";
+    static constexpr size_t MAGIC_SIZE     = sizeof( MAGIC ) - 1;
+    static constexpr size_t MAX_CACHE_SIZE = 64 * 1024;
+
+    const string           &board_cache_path( )
+    {
+        static const string path = [] {
+            const char *env = getenv( "TI_GPIO_BOARD_CACHE" );
+            return string( env != nullptr ? env : "" );
+        }( );
+        return path;
+    }
+
+    // Reads the fields of a mapped cache file, failing past its end
+    class CacheReader
+    {
+      public:
+        CacheReader( const char *data, size_t size )
+            : m_data( data ), m_size( size )
+        {
+        }
+
+        bool read( uint32_t &value )
+        {
+            if( m_size - m_pos < sizeof( value ) )
+            {
+                return false;
+            }
+            memcpy( &value, m_data + m_pos, sizeof( value ) );
+            m_pos += sizeof( value );
+            return true;
+        }
+
+        bool read( string_view &value )
+        {
+            uint32_t len;
+            if( !read( len ) || m_size - m_pos < len )
+            {
+                return false;
+            }
+            value = string_view( m_data + m_pos, len );
+            m_pos += len;
+            return true;
+        }
+
+        bool at_end( ) const { return m_pos == m_size; }
+
+      private:
+        const char *m_data;
+        size_t      m_size;
+        size_t      m_pos{ MAGIC_SIZE };
+    };
+
+    static bool _parse( const char *data, size_t size, BoardCache &cache )
+    {
+        if( size < MAGIC_SIZE || memcmp( data, MAGIC, MAGIC_SIZE ) != 0 )
+        {
+            return false;
+        }
+
+        CacheReader reader( data, size );
+        string_view compatible, boot_id, board_file, model;
+        uint32_t    count;
+        if( !reader.read( compatible ) || !reader.read( boot_id ) ||
+            !reader.read( board_file ) || !reader.read( model ) ||
+            !reader.read( count ) )
+        {
+            return false;
+        }
+
+        // Written for another board, before a reboot or with another board
+        // file, which may describe the board differently
+        if( compatible != cache.compatible || boot_id != cache.boot_id ||
+            board_file != cache.board_file )
+        {
+            return false;
+        }
+
+        vector<pair<string, string>> pwm_dirs{ };
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            string_view name, dir;
+            if( !reader.read( name ) || !reader.read( dir ) )
+            {
+                return false;
+            }
+            pwm_dirs.emplace_back( name, dir );
+        }
+
+        if( !reader.at_end( ) )
+        {
+            return false;
+        }
+
+        cache.model    = string( model );
+        cache.pwm_dirs = std::move( pwm_dirs );
+        return true;
+    }
+
+    bool read_board_cache( const string &path, BoardCache &cache )
+    {
+        int fd = ::open( path.c_str( ), O_RDONLY | O_CLOEXEC );
+        if( fd == -1 )
+        {
+            return false;
+        }
+
+        struct stat st{ };
+        if( fstat( fd, &st ) == -1 || st.st_size <= 0 ||
+            size_t( st.st_size ) > MAX_CACHE_SIZE )
+        {
+            ::close( fd );
+            return false;
+        }
+
+        size_t size = size_t( st.st_size );
+        void  *data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        ::close( fd );
+        if( data == MAP_FAILED )
+        {
+            return false;
+        }
+
+        bool found = _parse( static_cast<const char *>( data ), size, cache );
+        munmap( data, size );
+        return found;
+    }
+
+    static void _append( string &out, uint32_t value )
+    {
+        out.append( reinterpret_cast<const char *>( &value ), sizeof( value ) );
+    }
+
+    static void _append( string &out, const string &value )
+    {
+        _append( out, uint32_t( value.size( ) ) );
+        out.append( value );
+    }
+
+    void write_board_cache( const string &path, const BoardCache &cache )
+    {
+        string out( MAGIC, MAGIC_SIZE );
+        _append( out, cache.compatible );
+        _append( out, cache.boot_id );
+        _append( out, cache.board_file );
+        _append( out, cache.model );
+        _append( out, uint32_t( cache.pwm_dirs.size( ) ) );
+        for( const auto &pwm_dir : cache.pwm_dirs )
+        {
+            _append( out, pwm_dir.first );
+            _append( out, pwm_dir.second );
+        }
+
+        // Readers see the old file or the new one, never a partial write
+        string tmp_path = path + "." + to_string( getpid( ) );
+        int    fd       = ::open( tmp_path.c_str( ),
+                                  O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+        if( fd == -1 )
+        {
+            return;
+        }
+
+        bool written =
+            ::write( fd, out.data( ), out.size( ) ) == ssize_t( out.size( ) );
+        ::close( fd );
+
+        if( !written || rename( tmp_path.c_str( ), path.c_str( ) ) == -1 )
+        {
+            unlink( tmp_path.c_str( ) );
+        }
+    }
+
+} // namespace GPIO
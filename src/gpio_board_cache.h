@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_BOARD_CACHE_H
+#define GPIO_BOARD_CACHE_H
+
+// Standard headers
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GPIO
+{
+    /*
+    What discovering the board found, kept on disk between processes when
+    TI_GPIO_BOARD_CACHE names a file. The pin tables are compiled in, so
+    only the model matched from the device tree and the sysfs directories
+    of the PWM chips are kept. The file is only valid for the device tree
+    compatible string, the kernel boot id and the board file it was written
+    for.
+    */
+    struct BoardCache
+    {
+        std::string                                      compatible;
+        std::string                                      boot_id;
+        std::string                                      board_file;
+        std::string                                      model;
+
+        // PWM chip name and its pwmchip directory, "None" when not found
+        std::vector<std::pair<std::string, std::string>> pwm_dirs;
+    };
+
+    // The file named by TI_GPIO_BOARD_CACHE, empty when there is none
+    const std::string &board_cache_path( );
+
+    /*
+    Read the cache at path into cache. Returns false, leaving cache as it
+    was, if the file is missing, malformed or written for another
+    compatible string, boot id or board file key than those of cache.
+    */
+    bool read_board_cache( const std::string &path, BoardCache &cache );
+
+    /*
+    Replace the cache at path by cache, atomically. A cache that can't be
+    written is left alone, discovery just runs again in the next process.
+    */
+    void write_board_cache( const std::string &path, const BoardCache &cache );
+
+} // namespace GPIO
+
+#endif // GPIO_BOARD_CACHE_H
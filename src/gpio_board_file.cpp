@@ -0,0 +1,347 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard headers
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string_view>
+
+// Local headers
+#include "gpio_board_file.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    const string &board_file_path( )
+    {
+        static const string path = [] {
+            const char *env = getenv( "TI_GPIO_BOARD_FILE" );
+            return string( env != nullptr ? env : "" );
+        }( );
+        return path;
+    }
+
+    // A board of the file, its pins and compatible strings are ranges of
+    // those of the file
+    struct ParsedBoard
+    {
+        string_view name;
+        int         p1_revision{ 1 };
+        string_view ram{ "Unknown" };
+        string_view revision{ "Unknown" };
+        string_view type{ };
+        string_view manufacturer{ "Unknown" };
+        string_view processor{ "Unknown" };
+        size_t      first_pin;
+        size_t      first_compat;
+    };
+
+    /*
+    The board file and the tables parsed from it. Every name is a view of
+    content, so a pin costs no allocation.
+    */
+    class BoardFile
+    {
+      private:
+        BoardFile( );
+
+        void parse( );
+
+      public:
+        string                  content;
+        vector<PinDefinition>   pins;
+        vector<string_view>     compats;
+        vector<BoardDefinition> boards;
+
+        BoardFile( const BoardFile & )            = delete;
+        BoardFile &operator=( const BoardFile & ) = delete;
+
+        static BoardFile &get_instance( )
+        {
+            static BoardFile singleton{ };
+            return singleton;
+        }
+    };
+
+    static string _read_board_file( const string &path )
+    {
+        int fd = ::open( path.c_str( ), O_RDONLY | O_CLOEXEC );
+        if( fd == -1 )
+        {
+            throw runtime_error( "Can't open board file " + path );
+        }
+
+        struct stat st{ };
+        string      content{ };
+        if( fstat( fd, &st ) == 0 && st.st_size > 0 )
+        {
+            content.resize( size_t( st.st_size ) );
+        }
+
+        ssize_t got = content.empty( ) ? 0
+                                       : ::read( fd, content.data( ),
+                                                 content.size( ) );
+        ::close( fd );
+        if( got != ssize_t( content.size( ) ) )
+        {
+            throw runtime_error( "Can't read board file " + path );
+        }
+
+        return content;
+    }
+
+    // The next word of rest, removed from it, empty at the end
+    static string_view _next_token( string_view &rest )
+    {
+        size_t start = rest.find_first_not_of( " \t" );
+        if( start == string_view::npos )
+        {
+            rest = { };
+            return { };
+        }
+
+        rest.remove_prefix( start );
+        string_view token = rest.substr( 0, rest.find_first_of( " \t" ) );
+        rest.remove_prefix( token.size( ) );
+        return token;
+    }
+
+    static string_view _trim( string_view s )
+    {
+        size_t start = s.find_first_not_of( " \t" );
+        if( start == string_view::npos )
+        {
+            return { };
+        }
+
+        return s.substr( start, s.find_last_not_of( " \t" ) - start + 1 );
+    }
+
+    template <typename T> static bool _to_number( string_view s, T &value )
+    {
+        auto result = from_chars( s.data( ), s.data( ) + s.size( ), value );
+        return result.ec == errc( ) && result.ptr == s.data( ) + s.size( );
+    }
+
+    BoardFile::BoardFile( ) : content( ), pins( ), compats( ), boards( )
+    {
+        if( !board_file_path( ).empty( ) )
+        {
+            content = _read_board_file( board_file_path( ) );
+            parse( );
+        }
+    }
+
+    void BoardFile::parse( )
+    {
+        // One pin per line at most, the table is allocated once
+        pins.reserve(
+            size_t( count( content.begin( ), content.end( ), '\n' ) ) + 1 );
+
+        vector<ParsedBoard> parsed{ };
+        string_view         rest    = content;
+        size_t              line_no = 0;
+
+        while( !rest.empty( ) )
+        {
+            size_t      end  = rest.find( '\n' );
+            string_view line = rest.substr( 0, end );
+            rest.remove_prefix( end == string_view::npos ? rest.size( )
+                                                         : end + 1 );
+            line_no++;
+
+            auto fail = [&]( const string &what ) {
+                throw runtime_error( board_file_path( ) + ":" +
+                                     to_string( line_no ) + ": " + what );
+            };
+
+            line              = line.substr( 0, line.find_first_of( "#\r" ) );
+            string_view key   = _next_token( line );
+            string_view value = _trim( line );
+            if( key.empty( ) )
+            {
+                continue;
+            }
+
+            if( key == "board" )
+            {
+                if( value.empty( ) )
+                {
+                    fail( "board without a name" );
+                }
+                for( const ParsedBoard &b : parsed )
+                {
+                    if( b.name == value )
+                    {
+                        fail( "board " + string( value ) + " defined twice" );
+                    }
+                }
+
+                ParsedBoard board{ };
+                board.name         = value;
+                board.type         = value;
+                board.first_pin    = pins.size( );
+                board.first_compat = compats.size( );
+                parsed.push_back( board );
+                continue;
+            }
+
+            if( parsed.empty( ) )
+            {
+                fail( string( key ) + " before the first board" );
+            }
+
+            ParsedBoard &board = parsed.back( );
+            if( key == "pin" )
+            {
+                string_view columns[8];
+                for( string_view &column : columns )
+                {
+                    column = _next_token( value );
+                }
+
+                int          gpiochip = 0;
+                unsigned int offset   = 0;
+                int          pwm_id   = 0;
+                if( columns[7].empty( ) || !_next_token( value ).empty( ) )
+                {
+                    fail( "a pin needs 8 columns" );
+                }
+                if( !_to_number( columns[0], gpiochip ) ||
+                    !_to_number( columns[1], offset ) ||
+                    !_to_number( columns[7], pwm_id ) )
+                {
+                    fail( "invalid GPIO chip, line offset or PWM id" );
+                }
+
+                pins.push_back( PinDefinition{ gpiochip, offset, columns[2],
+                                               columns[3], columns[4],
+                                               columns[5], columns[6],
+                                               pwm_id } );
+            }
+            else if( key == "compatible" )
+            {
+                compats.push_back( value );
+            }
+            else if( key == "p1_revision" )
+            {
+                if( !_to_number( value, board.p1_revision ) )
+                {
+                    fail( "invalid p1_revision" );
+                }
+            }
+            else if( key == "ram" )
+            {
+                board.ram = value;
+            }
+            else if( key == "revision" )
+            {
+                board.revision = value;
+            }
+            else if( key == "type" )
+            {
+                board.type = value;
+            }
+            else if( key == "manufacturer" )
+            {
+                board.manufacturer = value;
+            }
+            else if( key == "processor" )
+            {
+                board.processor = value;
+            }
+            else
+            {
+                fail( "unknown key " + string( key ) );
+            }
+        }
+
+        if( parsed.empty( ) )
+        {
+            throw runtime_error( "No board in board file " +
+                                 board_file_path( ) );
+        }
+
+        // The rows of a board end where those of the next one start
+        boards.reserve( parsed.size( ) );
+        for( size_t i = 0; i < parsed.size( ); i++ )
+        {
+            const ParsedBoard &b    = parsed[i];
+            bool               last = i + 1 == parsed.size( );
+            size_t end_pin = last ? pins.size( ) : parsed[i + 1].first_pin;
+            size_t end_compat =
+                last ? compats.size( ) : parsed[i + 1].first_compat;
+
+            if( end_pin == b.first_pin )
+            {
+                throw runtime_error( "Board " + string( b.name ) +
+                                     " of the board file has no pin" );
+            }
+
+            boards.push_back( BoardDefinition{
+                Model::CUSTOM, b.name,
+                PinInfo{ b.p1_revision, b.ram, b.revision, b.type,
+                         b.manufacturer, b.processor },
+                pins.data( ) + b.first_pin, end_pin - b.first_pin,
+                compats.data( ) + b.first_compat,
+                end_compat - b.first_compat } );
+        }
+    }
+
+    const vector<BoardDefinition> &board_file_boards( )
+    {
+        return BoardFile::get_instance( ).boards;
+    }
+
+    const string &board_file_key( )
+    {
+        static const string key = [] {
+            if( board_file_path( ).empty( ) )
+            {
+                return string( );
+            }
+
+            // 64 bit FNV-1a
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for( char c : BoardFile::get_instance( ).content )
+            {
+                hash = ( hash ^ uint8_t( c ) ) * 0x100000001b3ull;
+            }
+
+            char hex[17];
+            snprintf( hex, sizeof( hex ), "%016llx",
+                      static_cast<unsigned long long>( hash ) );
+            return board_file_path( ) + "\n" + hex;
+        }( );
+        return key;
+    }
+
+} // namespace GPIO
@@ -0,0 +1,73 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_BOARD_FILE_H
+#define GPIO_BOARD_FILE_H
+
+// Standard headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "gpio_pin_data.h"
+
+namespace GPIO
+{
+    // The file named by TI_GPIO_BOARD_FILE, empty when there is none
+    const std::string &board_file_path( );
+
+    /*
+    The boards described by the board file, in the order of the file, empty
+    without a file. The file is read and parsed on the first call only, the
+    names of the boards point into its content, which is kept until the
+    process exits. Throws runtime_error if the file can't be read or names
+    the line it can't parse.
+
+    A line holds a key and its value, "#" starts a comment:
+
+        board        ACME_CARRIER          starts a board, named like a model
+        compatible   acme,carrier          device tree compatible string
+        type         Acme carrier          BOARD_INFO fields, the rest of the
+        ram          4096M                 line, "Unknown" when not given and
+        revision     B                     the board name for type
+        manufacturer Acme
+        processor    ARM A72
+        p1_revision  1
+        pin          1 84 600000.gpio 3 2 GPIO0_84 None -1
+
+    A pin has the columns of the built-in tables: GPIO chip, line offset,
+    GPIO chip sysfs directory, BOARD, BCM and SOC names, PWM chip sysfs
+    directory and PWM id.
+    */
+    const std::vector<BoardDefinition> &board_file_boards( );
+
+    /*
+    The path of the board file and a hash of its content, empty without a
+    file. A board found with another file, or another version of it, must
+    not be used.
+    */
+    const std::string &board_file_key( );
+
+} // namespace GPIO
+
+#endif // GPIO_BOARD_FILE_H
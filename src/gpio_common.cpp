@@ -64,7 +64,7 @@ GlobalVariableWrapper &GlobalVariableWrapper::get_instance( )
 string GlobalVariableWrapper::get_model( )
 {
     auto &instance = get_instance( );
-    auto  ret      = ModelToString( instance._model );
+    auto  ret      = string( instance._pinData.model_name );
     if( is_None( ret ) )
     {
         throw runtime_error( "get_model error" );
@@ -91,7 +91,8 @@ string GlobalVariableWrapper::get_BOARD_INFO( )
 GlobalVariableWrapper::GlobalVariableWrapper( )
     : _pinData( get_data( ) ), // Get GPIO pin data
       _model( _pinData.model ), _BOARD_INFO( _pinData.pin_info ),
-      _channel_data_by_mode( _pinData.channel_data ), _gpio_warnings( true ),
-      _gpio_mode( NumberingModes::None )
+      _channel_data_by_mode( ), _channel_data( nullptr ),
+      _gpio_warnings( true ), _gpio_mode( NumberingModes::None ),
+      _merge_chip_requests( false )
 {
 }
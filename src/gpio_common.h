@@ -28,7 +28,9 @@ DEALINGS IN THE SOFTWARE.
 #define GPIO_COMMON_H
 
 // Standard headers
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 
@@ -66,14 +68,24 @@ namespace GPIO
         PinData       _pinData;
         const Model   _model;
         const PinInfo _BOARD_INFO;
-        const std::map<GPIO::NumberingModes, std::map<std::string, ChannelInfo>>
-            _channel_data_by_mode;
 
-        // A map used as lookup tables for pin to linux gpio mapping
-        std::map<std::string, ChannelInfo> _channel_data;
+        // Lookup tables of the numbering modes, each built by the first
+        // setmode() of its mode under _channel_data_lock and never freed
+        std::map<GPIO::NumberingModes, std::map<std::string, ChannelInfo>>
+                   _channel_data_by_mode;
+        std::mutex _channel_data_lock;
 
-        bool                               _gpio_warnings;
-        NumberingModes                     _gpio_mode;
+        // The map of _channel_data_by_mode used as lookup table for pin to
+        // linux gpio mapping, nullptr until a mode is set
+        std::atomic<const std::map<std::string, ChannelInfo> *> _channel_data;
+
+        std::atomic_bool                   _gpio_warnings;
+        std::atomic<NumberingModes>        _gpio_mode;
+        std::atomic_bool                   _merge_chip_requests;
+
+        // Channels set up by this process, guarded by _config_lock. The
+        // input()/output() fast path reads LineState::direction instead.
+        std::mutex                         _config_lock;
         std::map<std::string, Directions>  _channel_configuration;
         std::map<std::string, bool>        _pwm_channels;
 
@@ -91,16 +103,24 @@ namespace GPIO
         GlobalVariableWrapper( );
     };
 
-    void _cleanup_all( );
+    void               _cleanup_all( );
+
+    const ChannelInfo &_channel_to_info( const std::string &channel,
+                                         bool               need_gpio = false,
+                                         bool               need_pwm  = false );
+
+    class LineState;
 
-    // handler to call the event callbacks
-    void callback_handler( int channel );
+    class LineRequest;
 
-    // start and stop threads
-    void       start_thread( int channel );
-    void       stop_thread( );
+    // handler to call the event callbacks of the lines of a request with
+    // pending events
+    void       callback_handler( LineRequest &line_request );
 
     Directions _app_channel_configuration( const ChannelInfo &ch_info );
+    void       _set_app_channel_configuration( const std::string &channel,
+                                               Directions         direction );
+    bool       _is_pwm_channel( const std::string &channel );
     Directions _channel_configuration( const ChannelInfo &ch_info );
 
 } // namespace GPIO
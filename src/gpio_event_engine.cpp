@@ -0,0 +1,291 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+// Standard headers
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_common.h"
+#include "gpio_event_engine.h"
+
+#define MAX_EPOLL_EVENTS 16
+
+using namespace std;
+
+namespace GPIO
+{
+    EventEngine &EventEngine::get_instance( )
+    {
+        static EventEngine singleton{ };
+        return singleton;
+    }
+
+    EventEngine::EventEngine( )
+    {
+        m_epoll_fd = epoll_create1( EPOLL_CLOEXEC );
+        m_wake_fd  = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+        if( m_epoll_fd == -1 || m_wake_fd == -1 )
+        {
+            throw runtime_error( "Could not create the event poller: " +
+                                 string( strerror( errno ) ) );
+        }
+
+        // The wake up fd is the only one registered without a line
+        epoll_event ev{ };
+        ev.events   = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if( epoll_ctl( m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &ev ) == -1 )
+        {
+            throw runtime_error( "Could not register the wake up event: " +
+                                 string( strerror( errno ) ) );
+        }
+    }
+
+    EventEngine::~EventEngine( )
+    {
+        stop( );
+
+        close( m_wake_fd );
+        close( m_epoll_fd );
+    }
+
+    void EventEngine::start( )
+    {
+        if( m_thread.joinable( ) )
+        {
+            // Restarted from a callback after stop(), keep the thread running
+            if( this_thread::get_id( ) == m_thread.get_id( ) )
+            {
+                m_stop = false;
+                return;
+            }
+
+            if( !m_stop )
+            {
+                return;
+            }
+
+            // stop() was called from a callback, reap the old thread
+            m_thread.join( );
+        }
+
+        m_stop   = false;
+        m_thread = thread( [this] { run( ); } );
+    }
+
+    void EventEngine::stop( )
+    {
+        if( !m_thread.joinable( ) )
+        {
+            return;
+        }
+
+        m_stop         = true;
+
+        uint64_t value = 1;
+        if( write( m_wake_fd, &value, sizeof( value ) ) == -1 )
+        {
+            cerr << "[WARNING] Could not wake up the event thread: "
+                 << strerror( errno ) << endl;
+        }
+
+        // A callback stopping the engine can't join its own thread, the
+        // thread is joined on the next start() or stop() instead
+        if( this_thread::get_id( ) != m_thread.get_id( ) )
+        {
+            m_thread.join( );
+        }
+    }
+
+    void EventEngine::watch( LineState &state )
+    {
+        lock_guard<recursive_mutex> chip_lock( state.chip_lock );
+        lock_guard<recursive_mutex> lock( m_lock );
+
+        if( state.watched )
+        {
+            return;
+        }
+
+        // The fd of a request is registered once, for its first watched line
+        LineRequest &line_request = *state.line_request;
+        if( line_request.watcher == nullptr )
+        {
+            epoll_event ev{ };
+            ev.events   = EPOLLIN;
+            ev.data.ptr = &state;
+
+            int fd      = state.request->fd( );
+            if( epoll_ctl( m_epoll_fd, EPOLL_CTL_ADD, fd, &ev ) == -1 )
+            {
+                throw runtime_error( "Could not watch channel " +
+                                     state.channel +
+                                     " for events: " + strerror( errno ) );
+            }
+            line_request.watcher = &state;
+        }
+
+        state.watched = true;
+        start( );
+    }
+
+    void EventEngine::unwatch( LineState &state )
+    {
+        lock_guard<recursive_mutex> chip_lock( state.chip_lock );
+
+        if( !state.watched )
+        {
+            return;
+        }
+
+        state.watched = false;
+        state.mirror.enabled.store( false, memory_order_release );
+
+        // Hand the fd over to another watched line of the request, if any
+        LineRequest &line_request = *state.line_request;
+        if( line_request.watcher != &state )
+        {
+            return;
+        }
+
+        LineState *watcher = nullptr;
+        for( LineState *line : line_request.lines )
+        {
+            if( line->watched )
+            {
+                watcher = line;
+                break;
+            }
+        }
+
+        int fd = state.request->fd( );
+        if( watcher != nullptr )
+        {
+            epoll_event ev{ };
+            ev.events   = EPOLLIN;
+            ev.data.ptr = watcher;
+            epoll_ctl( m_epoll_fd, EPOLL_CTL_MOD, fd, &ev );
+        }
+        else
+        {
+            epoll_ctl( m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr );
+        }
+
+        line_request.watcher = watcher;
+        m_generation++;
+    }
+
+    void EventEngine::mirror( LineState &state )
+    {
+        lock_guard<recursive_mutex> chip_lock( state.chip_lock );
+
+        // The time is taken before the level is read: edges older than it
+        // are in the value read here, even if the event thread dispatches
+        // them after the lock is released, and are dropped then
+        timespec ts{ };
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+
+        int value = state.request->get_value( state.offset );
+        if( value == -1 )
+        {
+            throw runtime_error( "Could not read channel " + state.channel );
+        }
+
+        state.mirror.seed( value, uint64_t( ts.tv_sec ) * 1000000000ull +
+                                      ts.tv_nsec );
+        state.mirror.overflowed.store( false, memory_order_relaxed );
+
+        watch( state );
+        state.mirror.enabled.store( true, memory_order_release );
+    }
+
+    void EventEngine::run( )
+    {
+        epoll_event events[MAX_EPOLL_EVENTS];
+
+        while( !m_stop )
+        {
+            unsigned long generation = m_generation;
+            int count = epoll_wait( m_epoll_fd, events, MAX_EPOLL_EVENTS, -1 );
+            if( count == -1 )
+            {
+                if( errno == EINTR )
+                {
+                    continue;
+                }
+
+                cerr << "[Exception] epoll_wait failed: " << strerror( errno )
+                     << " (caught from: EventEngine::run())" << endl;
+                break;
+            }
+
+            for( int i = 0; i < count && !m_stop; i++ )
+            {
+                auto *state = static_cast<LineState *>( events[i].data.ptr );
+                if( state == nullptr )
+                {
+                    uint64_t value;
+                    while( read( m_wake_fd, &value, sizeof( value ) ) > 0 )
+                    {
+                    }
+                    continue;
+                }
+
+                lock_guard<recursive_mutex> lock( state->chip_lock );
+
+                // A line may have been unwatched, or its request replaced,
+                // after epoll_wait returned. The fd is level triggered, so
+                // skipping its events only postpones those still pending.
+                if( m_generation != generation )
+                {
+                    continue;
+                }
+
+                // Kept alive if a callback requests the lines again
+                shared_ptr<LineRequest> line_request = state->line_request;
+                try
+                {
+                    callback_handler( *line_request );
+                }
+                catch( exception &e )
+                {
+                    cerr << "[Exception] " << e.what( )
+                         << " (caught from: EventEngine::run())" << endl;
+                }
+            }
+        }
+    }
+
+} // namespace GPIO
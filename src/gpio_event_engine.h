@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_EVENT_ENGINE_H
+#define GPIO_EVENT_ENGINE_H
+
+// Standard headers
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// Local headers
+#include "gpio_line.h"
+
+namespace GPIO
+{
+    /*
+    Single event thread serving every line registered with
+    add_event_detect(). The line request fds are multiplexed with epoll and
+    callback_handler() is run for each request with pending edge events, so
+    the number of threads does not depend on the number of watched channels.
+    Events are dispatched with the chip lock of the lines held, so threads
+    working on lines of other gpiochips are not blocked by callbacks.
+    */
+    class EventEngine
+    {
+      public:
+        EventEngine( const EventEngine & )            = delete;
+        EventEngine &operator=( const EventEngine & ) = delete;
+        ~EventEngine( );
+
+        static EventEngine &get_instance( );
+
+        // Start dispatching the edge events of the line, starting the event
+        // thread if needed
+        void watch( LineState &state );
+
+        // Stop dispatching the edge events of the line. Once this returns
+        // no callback of the line is running on the event thread, unless it
+        // is called from a callback. Stops mirroring its input.
+        // watch(), unwatch() and mirror() take the chip lock of the line.
+        void unwatch( LineState &state );
+
+        // Start mirroring the input of a line detecting both edges, seeding
+        // the mirror with the current level, and watch the line
+        void mirror( LineState &state );
+
+        // Stop the event thread and wait for it to exit
+        void stop( );
+
+      private:
+        EventEngine( );
+        void start( );
+        void run( );
+
+      private:
+        int                  m_epoll_fd{ -1 };
+        int                  m_wake_fd{ -1 };
+        std::thread          m_thread;
+        std::atomic_bool     m_stop{ false };
+
+        // Guards starting and stopping the thread
+        std::recursive_mutex m_lock;
+
+        // Incremented, under a chip lock, whenever an fd is unregistered or
+        // handed over to another line
+        std::atomic<unsigned long> m_generation{ 0 };
+    };
+
+} // namespace GPIO
+
+#endif // GPIO_EVENT_ENGINE_H
@@ -29,8 +29,8 @@ DEALINGS IN THE SOFTWARE.
 
 // Standard headers
 #include <chrono>
+#include <fstream>
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 
 // Interface headers
@@ -46,17 +46,17 @@ namespace GPIO
 {
     string hw_pwm_path( const ChannelInfo &ch_info )
     {
-        return ch_info.pwm_chip_dir + "/pwm" + to_string( ch_info.pwm_id );
+        return ch_info.pwm_chip_dir( ) + "/pwm" + to_string( ch_info.pwm_id );
     }
 
     string hw_pwm_export_path( const ChannelInfo &ch_info )
     {
-        return ch_info.pwm_chip_dir + "/export";
+        return ch_info.pwm_chip_dir( ) + "/export";
     }
 
     string hw_pwm_unexport_path( const ChannelInfo &ch_info )
     {
-        return ch_info.pwm_chip_dir + "/unexport";
+        return ch_info.pwm_chip_dir( ) + "/unexport";
     }
 
     string hw_pwm_period_path( const ChannelInfo &ch_info )
@@ -103,13 +103,23 @@ namespace GPIO
             }
         }
 
-        ch_info.f_duty_cycle->open( hw_pwm_duty_cycle_path( ch_info ),
-                                    std::ios::in | std::ios::out );
+        PwmFiles &files = *ch_info.pwm_files;
+        files.period.open( hw_pwm_period_path( ch_info ) );
+        files.duty_cycle.open( hw_pwm_duty_cycle_path( ch_info ) );
+        files.enable.open( hw_pwm_enable_path( ch_info ) );
+    }
+
+    void hw_close_pwm( const ChannelInfo &ch_info )
+    {
+        PwmFiles &files = *ch_info.pwm_files;
+        files.period.close( );
+        files.duty_cycle.close( );
+        files.enable.close( );
     }
 
     void hw_unexport_pwm( const ChannelInfo &ch_info )
     {
-        ch_info.f_duty_cycle->close( );
+        hw_close_pwm( ch_info );
 
         ofstream f( hw_pwm_unexport_path( ch_info ) );
         f << ch_info.pwm_id;
@@ -117,8 +127,7 @@ namespace GPIO
 
     void hw_set_pwm_period( const ChannelInfo &ch_info, const int period_ns )
     {
-        ofstream f( hw_pwm_period_path( ch_info ) );
-        f << period_ns;
+        ch_info.pwm_files->period.write( period_ns );
     }
 
     void hw_set_pwm_duty_cycle( const ChannelInfo &ch_info,
@@ -127,41 +136,26 @@ namespace GPIO
         // On boot, both period and duty cycle are both 0. In this state, the
         // period must be set first; any configuration change made while
         // period==0 is rejected. This is fine if we actually want a duty cycle
-        // of 0. Later, once any period has been set, we will always be able to
-        // set a duty cycle of 0. The code could be written to always read the
-        // current value, and only write the value if the desired value is
-        // different. However, we enable this check only for the 0 duty cycle
-        // case, to avoid having to read the current value every time the duty
-        // cycle is set.
-        if( duty_cycle_ns == 0 )
-        {
-            ch_info.f_duty_cycle->seekg( 0, std::ios::beg );
-            stringstream buffer{ };
-            buffer << ch_info.f_duty_cycle->rdbuf( );
-            auto cur = buffer.str( );
-            cur      = strip( cur );
-
-            if( cur == "0" )
-            {
-                return;
-            }
-        }
-
-        ch_info.f_duty_cycle->seekg( 0, std::ios::beg );
-        *ch_info.f_duty_cycle << duty_cycle_ns;
-        ch_info.f_duty_cycle->flush( );
+        // of 0. The attribute caches the value read when it was opened and
+        // every value written since, so a duty cycle it already holds is
+        // never written again.
+        ch_info.pwm_files->duty_cycle.write( duty_cycle_ns );
     }
 
     void hw_enable_pwm( const ChannelInfo &ch_info )
     {
-        ofstream f( hw_pwm_enable_path( ch_info ) );
-        f << 1;
+        ch_info.pwm_files->enable.write( 1 );
     }
 
     void hw_disable_pwm( const ChannelInfo &ch_info )
     {
-        ofstream f( hw_pwm_enable_path( ch_info ) );
-        f << 0;
+        // Nothing to disable once the channel has been unexported
+        if( !ch_info.pwm_files->enable.is_open( ) )
+        {
+            return;
+        }
+
+        ch_info.pwm_files->enable.write( 0 );
     }
 
     GpioPwmIfHw::GpioPwmIfHw( int channel, int frequency_hz )
@@ -212,7 +206,7 @@ namespace GPIO
             // Anything that doesn't match new frequency_hz
             m_frequency_hz = -1 * frequency_hz;
             _reconfigure( frequency_hz, 0.0 );
-            global._channel_configuration[to_string( channel )] = HARD_PWM;
+            _set_app_channel_configuration( to_string( channel ), HARD_PWM );
         }
 
         catch( exception &e )
@@ -245,6 +239,7 @@ namespace GPIO
                 return;
             }
             hw_disable_pwm( m_ch_info );
+            m_started = false;
         }
 
         catch( exception &e )
@@ -255,6 +250,13 @@ namespace GPIO
         }
     }
 
+    /*
+    Change the period and duty cycle without disabling the output. The kernel
+    rejects a duty cycle longer than the period, so the period is written
+    first unless it gets shorter than the current duty cycle, in which case
+    the (shorter) new duty cycle goes first. Either way every intermediate
+    state is valid and the PWM keeps running.
+    */
     void GpioPwmIfHw::_reconfigure( int frequency_hz, double duty_cycle_percent,
                                     bool start )
     {
@@ -263,37 +265,51 @@ namespace GPIO
             throw runtime_error( "invalid duty_cycle_percent" );
         }
 
-        bool freq_change = start || ( frequency_hz != m_frequency_hz );
-        bool stop        = m_started && freq_change;
+        int period_ns = m_period_ns;
+        if( frequency_hz != m_frequency_hz )
+        {
+            if( frequency_hz <= 0 )
+            {
+                throw runtime_error( "Invalid frequency" );
+            }
+            period_ns = int( 1000000000.0 / frequency_hz );
+        }
+
+        int duty_cycle_ns = int( period_ns * ( duty_cycle_percent / 100.0 ) );
 
-        if( stop )
+        long long current_duty = m_ch_info.pwm_files->duty_cycle.cached( );
+        if( current_duty < 0 )
         {
-            m_started = false;
-            hw_disable_pwm( m_ch_info );
+            current_duty = m_duty_cycle_ns;
         }
 
-        if( freq_change )
+        if( period_ns >= current_duty )
         {
-            m_frequency_hz = frequency_hz;
-            m_period_ns    = int( 1000000000.0 / frequency_hz );
-            hw_set_pwm_period( m_ch_info, m_period_ns );
+            hw_set_pwm_period( m_ch_info, period_ns );
+            hw_set_pwm_duty_cycle( m_ch_info, duty_cycle_ns );
+        }
+        else
+        {
+            hw_set_pwm_duty_cycle( m_ch_info, duty_cycle_ns );
+            hw_set_pwm_period( m_ch_info, period_ns );
         }
 
+        m_frequency_hz       = frequency_hz;
+        m_period_ns          = period_ns;
         m_duty_cycle_percent = duty_cycle_percent;
-        m_duty_cycle_ns = int( m_period_ns * ( duty_cycle_percent / 100.0 ) );
+        m_duty_cycle_ns      = duty_cycle_ns;
 
-        if( stop || start )
+        if( start && !m_started )
         {
             hw_enable_pwm( m_ch_info );
             m_started = true;
         }
-
-        hw_set_pwm_duty_cycle( m_ch_info, m_duty_cycle_ns );
     }
 
     GpioPwmIfHw::~GpioPwmIfHw( )
     {
         stop( );
+        hw_close_pwm( m_ch_info );
     }
 
 } // namespace GPIO
@@ -0,0 +1,405 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_LINE_H
+#define GPIO_LINE_H
+
+// Standard headers
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_backend.h"
+#include "gpio_pin_data.h"
+
+namespace GPIO
+{
+    class LineState;
+
+    // Callbacks of a line, replaced as a whole when one is added or removed
+    using CallbackList = std::vector<Callback>;
+
+    /*
+    A line request of the backend, shared by the LineStates of the lines it
+    covers. setup() of a list of channels requests all the lines of a
+    gpiochip at once, as does merge_chip_requests() for every line of a
+    gpiochip. Reconfiguring applies the configuration of every line of the
+    request, found through lines.
+    Its fd is watched by the event thread while any of its lines is, the
+    events read from it are demultiplexed to the lines by offset. The
+    members below request are guarded by the chip lock of the lines, except
+    write_lock. The request is released with the last LineState referring
+    to it.
+    */
+    class LineRequest
+    {
+      public:
+        LineRequest( std::unique_ptr<BackendRequest> request,
+                     size_t                          event_buffer_size )
+            : request( std::move( request ) ),
+              event_buffer_size( event_buffer_size )
+        {
+        }
+
+        LineRequest( const LineRequest & )            = delete;
+        LineRequest &operator=( const LineRequest & ) = delete;
+
+      public:
+        const std::unique_ptr<BackendRequest> request;
+        const size_t event_buffer_size; // of the kernel, 0 for its default
+        std::vector<LineState *>              lines;
+
+        // Watched line the event thread is given for the fd, or nullptr
+        LineState                            *watcher{ nullptr };
+
+        // Edge events of all the lines, read at once
+        std::vector<EdgeEvent>                events;
+
+        // Call of wait_for_edges() reading the events of the request, which
+        // isn't watched meanwhile, or nullptr
+        const void                           *waiter{ nullptr };
+
+        // Taken by the writes to the lines, so that the value set and the
+        // driven value of a line can't be interleaved by another writer
+        std::mutex                            write_lock;
+    };
+
+    /*
+    Level of a mirrored input, kept by the event thread from the edge events
+    of the line. input() reads value on its own, status() reads the other
+    fields together through a sequence lock. Writers hold the chip lock of
+    the line, so there is a single writer at a time.
+    */
+    class InputMirror
+    {
+      public:
+        void update( int value, uint64_t timestamp_ns,
+                     unsigned long line_seqno )
+        {
+            unsigned version = m_version.load( std::memory_order_relaxed );
+            m_version.store( version + 1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+
+            this->value.store( value, std::memory_order_relaxed );
+            m_timestamp_ns.store( timestamp_ns, std::memory_order_relaxed );
+            m_line_seqno.store( line_seqno, std::memory_order_relaxed );
+
+            m_version.store( version + 2, std::memory_order_release );
+        }
+
+        // Set the level read at timestamp_ns, edges older than it are
+        // already in value and must not be applied anymore
+        void seed( int value, uint64_t timestamp_ns )
+        {
+            m_seed_ns = timestamp_ns;
+            update( value, timestamp_ns, 0 );
+        }
+
+        // Whether an edge happened after the level was seeded
+        bool is_newer( uint64_t timestamp_ns ) const
+        {
+            return timestamp_ns >= m_seed_ns;
+        }
+
+        // Sequence number of the last edge applied, 0 if none
+        unsigned long line_seqno( ) const
+        {
+            return m_line_seqno.load( std::memory_order_relaxed );
+        }
+
+        InputMirrorStatus status( ) const
+        {
+            InputMirrorStatus status{ };
+            unsigned          version;
+
+            do
+            {
+                version = m_version.load( std::memory_order_acquire );
+                status.value = value.load( std::memory_order_relaxed );
+                status.timestamp_ns =
+                    m_timestamp_ns.load( std::memory_order_relaxed );
+                status.line_seqno =
+                    m_line_seqno.load( std::memory_order_relaxed );
+                std::atomic_thread_fence( std::memory_order_acquire );
+            } while( ( version & 1 ) != 0 ||
+                     version != m_version.load( std::memory_order_relaxed ) );
+
+            status.stale = !enabled.load( std::memory_order_acquire );
+            return status;
+        }
+
+      public:
+        std::atomic_bool           enabled{ false };
+        std::atomic<int>           value{ LOW };
+        std::atomic_bool           overflowed{ false }; // since last status
+
+      private:
+        std::atomic<unsigned>      m_version{ 0 };
+        std::atomic<uint64_t>      m_timestamp_ns{ 0 };
+        std::atomic<unsigned long> m_line_seqno{ 0 };
+        uint64_t                   m_seed_ns{ 0 }; // under the chip lock
+    };
+
+    /*
+    State of a single GPIO line requested by this process.
+    One LineState exists per (gpiochip, offset) pair of the board. They are
+    all created at startup and never freed, so looking one up needs no lock
+    and the pointer held by a GPIO::Line handle stays valid across
+    reconfiguration and cleanup of the channel.
+
+    Setting up, reconfiguring and cleaning up the line, its event detection,
+    and dispatching its edge events hold chip_lock, shared by the lines of
+    the gpiochip since they may share a line request. input() and output()
+    take no chip lock: they enter the line with a LineUse, then read
+    direction, which is stored after request is set, and the atomics below.
+    A write takes the write_lock of line_request while it sets the value and
+    stores driven, so concurrent writers of a line leave driven equal to the
+    value of the line. A write skipped because driven already has the value
+    takes no lock.
+
+    callbacks is an immutable snapshot. The event thread loads it with
+    std::atomic_load and runs it without further locking. Adding or removing
+    a callback copies the list and stores the new one with std::atomic_store
+    under callbacks_lock, so it never waits for the events being dispatched.
+    A snapshot loaded before a callback is removed may still run it once.
+    */
+    class LineState
+    {
+      public:
+        LineState( int chip_gpio, unsigned int offset,
+                   std::recursive_mutex &chip_lock )
+            : chip_gpio( chip_gpio ), offset( offset ), chip_lock( chip_lock )
+        {
+            config.offset = offset;
+        }
+
+        LineState( const LineState & )            = delete;
+        LineState &operator=( const LineState & ) = delete;
+
+      public:
+        std::string                  channel; // as last set up
+        const int                    chip_gpio;
+        const unsigned int           offset;
+        std::recursive_mutex        &chip_lock;
+
+        std::shared_ptr<LineRequest> line_request;
+        BackendRequest              *request{ nullptr }; // of line_request
+        LineConfig                   config{ };
+        std::atomic<Directions>      direction{ Directions::UNKNOWN };
+
+        // Lock free users of request and holds keeping them out, see LineUse
+        std::atomic<unsigned>        users{ 0 };
+        std::atomic<unsigned>        holds{ 0 };
+
+        // Value driven by the line while it is an output, -1 when unknown
+        std::atomic<int>             driven{ -1 };
+
+        // Writes made and skipped by output(), see output_stats()
+        std::atomic<unsigned long long> writes{ 0 };
+        std::atomic<unsigned long long> elided{ 0 };
+
+        // Event detection
+        bool                         watched{ false };
+        int                          event_channel{ 0 }; // passed to callbacks
+
+        // Edge events of the line, demultiplexed from those of the request.
+        // Sized by add_event_detect() so that dispatching doesn't allocate.
+        std::vector<EdgeEvent>       events;
+
+        // Events the kernel dropped since add_event_detect(), counted from
+        // the gaps in the sequence numbers of the line
+        std::atomic<unsigned long>   events_dropped{ 0 };
+        unsigned long                last_seqno{ 0 }; // 0 if none read yet
+        std::shared_ptr<const CallbackList> callbacks;
+        std::mutex                   callbacks_lock; // taken after chip_lock
+
+        // Edge given to add_event_detect(). The line detects both edges
+        // while its input is mirrored, callbacks only get this one.
+        std::atomic<Edge>            user_edge{ Edge::NONE };
+
+        InputMirror                  mirror;
+
+        // Events dispatched since the last event_detected()
+        std::atomic<int>             events_detected{ 0 };
+    };
+
+    /*
+    Use of the request of a line by the lock free paths: input(), output(),
+    Line and the software PWM thread. Entering only increments a counter of
+    the line. Reconfiguring or replacing the request holds its lines with
+    HeldLines, which keeps new users out and waits for the current ones to
+    leave: a write can't land between reading the value of an output and
+    reconfiguring it, and a request is never released while in use.
+    direction and request are only valid once the line is entered.
+    */
+    class LineUse
+    {
+      public:
+        LineUse( ) = default;
+
+        // Enter the line, waiting while it is held
+        explicit LineUse( LineState &state )
+        {
+            while( !enter( state ) )
+            {
+                wait( state );
+            }
+        }
+
+        LineUse( LineUse &&other ) noexcept : m_state( other.m_state )
+        {
+            other.m_state = nullptr;
+        }
+
+        LineUse &operator=( LineUse &&other ) noexcept
+        {
+            if( this != &other )
+            {
+                leave( );
+                m_state       = other.m_state;
+                other.m_state = nullptr;
+            }
+            return *this;
+        }
+
+        LineUse( const LineUse & )            = delete;
+        LineUse &operator=( const LineUse & ) = delete;
+
+        ~LineUse( ) { leave( ); }
+
+        // Enter the line unless it is held, leaving the line entered before
+        bool enter( LineState &state ) noexcept
+        {
+            leave( );
+
+            // Pairs with HeldLines: either the holder sees this user or
+            // this user sees the hold
+            state.users.fetch_add( 1, std::memory_order_seq_cst );
+            if( state.holds.load( std::memory_order_seq_cst ) == 0 )
+            {
+                m_state = &state;
+                return true;
+            }
+
+            state.users.fetch_sub( 1, std::memory_order_release );
+            return false;
+        }
+
+        void leave( ) noexcept
+        {
+            if( m_state != nullptr )
+            {
+                m_state->users.fetch_sub( 1, std::memory_order_release );
+                m_state = nullptr;
+            }
+        }
+
+        // Wait for the line not to be held any more
+        static void wait( const LineState &state ) noexcept
+        {
+            while( state.holds.load( std::memory_order_acquire ) != 0 )
+            {
+                std::this_thread::yield( );
+            }
+        }
+
+      private:
+        LineState *m_state{ nullptr };
+    };
+
+    /*
+    Holds lines, with their chip lock held, until destroyed. Holds nest, a
+    line held twice is released by the outer hold.
+    */
+    class HeldLines
+    {
+      public:
+        explicit HeldLines( LineState &state )
+            : m_single( &state ), m_states( &m_single ), m_count( 1 )
+        {
+            hold( );
+        }
+
+        explicit HeldLines( const std::vector<LineState *> &states )
+            : m_states( states.data( ) ), m_count( states.size( ) )
+        {
+            hold( );
+        }
+
+        HeldLines( const HeldLines & )            = delete;
+        HeldLines &operator=( const HeldLines & ) = delete;
+
+        ~HeldLines( )
+        {
+            for( size_t i = 0; i < m_count; i++ )
+            {
+                m_states[i]->holds.fetch_sub( 1, std::memory_order_release );
+            }
+        }
+
+      private:
+        void hold( )
+        {
+            for( size_t i = 0; i < m_count; i++ )
+            {
+                m_states[i]->holds.fetch_add( 1, std::memory_order_seq_cst );
+            }
+            for( size_t i = 0; i < m_count; i++ )
+            {
+                while( m_states[i]->users.load( std::memory_order_seq_cst ) !=
+                       0 )
+                {
+                    std::this_thread::yield( );
+                }
+            }
+        }
+
+      private:
+        LineState        *m_single{ nullptr };
+        LineState *const *m_states;
+        const size_t      m_count;
+    };
+
+    /*
+    Enter every line of states into uses. A line found held makes the lines
+    entered so far leave before waiting for it, so that a thread holding it
+    is never left waiting for them. uses is cleared first, it doesn't
+    allocate if its capacity is at least states.size().
+    */
+    void _enter_lines( const std::vector<LineState *> &states,
+                       std::vector<LineUse>            &uses );
+
+    // Return the state of the line backing ch_info
+    LineState &_line_state( const ChannelInfo &ch_info );
+
+} // namespace GPIO
+
+#endif // GPIO_LINE_H
@@ -28,7 +28,7 @@ DEALINGS IN THE SOFTWARE.
 #include <fstream>
 #include <iostream>
 #include <map>
-#include <set>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -41,6 +41,9 @@ DEALINGS IN THE SOFTWARE.
 #include <GPIO.h>
 
 // Local headers
+#include "gpio_backend.h"
+#include "gpio_board_cache.h"
+#include "gpio_board_file.h"
 #include "gpio_pin_data.h"
 #include "python_functions.h"
 
@@ -51,59 +54,13 @@ using namespace std::string_literals; // enables s-suffix for std::string
 namespace GPIO
 {
     /*
-    Global variables are wrapped in singleton pattern in order to avoid
-    initialization order of global variables in different compilation units
-    problem
+    These arrays contain all the relevant GPIO data for each Platform.
+    The values are use to generate dictionaries that map the corresponding
+    pin mode numbers to the Linux GPIO pin number and GPIO chip directory.
+    They are constant initialized, only the board found is ever read.
     */
 
-    class EntirePinData
-    {
-      private:
-        EntirePinData( );
-
-      public:
-        /*
-        These vectors contain all the relevant GPIO data for each Platform.
-        The values are use to generate dictionaries that map the corresponding
-        pin mode numbers to the Linux GPIO pin number and GPIO chip directory
-        */
-
-        const vector<PinDefinition>             J721E_SK_PIN_DEFS;
-        const vector<string>                    compats_j721e;
-
-        const vector<PinDefinition>             AM68_SK_PIN_DEFS;
-        const vector<string>                    compats_am68sk;
-
-        const vector<PinDefinition>             AM69_SK_PIN_DEFS;
-        const vector<string>                    compats_am69sk;
-
-        const vector<PinDefinition>             AM62A_SK_PIN_DEFS;
-        const vector<string>                    compats_am62ask;
-
-        const vector<PinDefinition>             AM62P_SK_PIN_DEFS;
-        const vector<string>                    compats_am62psk;
-
-        const vector<PinDefinition>             J722S_EVM_PIN_DEFS;
-        const vector<string>                    compats_j722sevm;
-
-        const map<Model, vector<PinDefinition>> PIN_DEFS_MAP;
-        const map<Model, PinInfo>               DEVICE_INFO_MAP;
-
-        EntirePinData( const EntirePinData & )            = delete;
-        EntirePinData &operator=( const EntirePinData & ) = delete;
-        ~EntirePinData( )                                 = default;
-
-        static EntirePinData &get_instance( )
-        {
-            static EntirePinData singleton{ };
-            return singleton;
-        }
-    };
-
-    EntirePinData::EntirePinData()
-    :
-    J721E_SK_PIN_DEFS
-    {
+    constexpr PinDefinition J721E_SK_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET Sysfs_dir   BOARD   BCM  SOC_NAME   PWM_SysFs     PWM_Id
         {1, 84, "600000.gpio",  "3",  "2", "GPIO0_84",  "None",        -1},
         {1, 83, "600000.gpio",  "5",  "3", "GPIO0_83",  "None",        -1},
@@ -131,14 +88,14 @@ namespace GPIO
         {1, 115, "600000.gpio", "37", "26", "GPIO0_115", "None",        -1},
         {1, 3, "600000.gpio", "38", "20", "GPIO0_3",   "None",        -1},
         {1, 4, "600000.gpio", "40", "21", "GPIO0_4",   "None",        -1}
-    },
-    compats_j721e
-    {
+    };
+
+    constexpr string_view compats_j721e[] = {
         "ti,j721e-eaikti",
         "ti,j721e"
-    },
-    AM68_SK_PIN_DEFS
-    {
+    };
+
+    constexpr PinDefinition AM68_SK_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET Sysfs_dir      BOARD   BCM  SOC_NAME      PWM_SysFs PWM_Id
         {4, 4, "600000.gpio",    "3",  "2", "GPIO0_4",       "None", -1},
         {4, 5, "600000.gpio",    "5",  "3", "GPIO0_5",       "None", -1},
@@ -166,14 +123,14 @@ namespace GPIO
         {4, 27, "600000.gpio",   "37", "26", "GPIO0_27",      "None", -1},
         {4, 48, "600000.gpio",   "38", "20", "GPIO0_48",      "None", -1},
         {4, 45, "600000.gpio",   "40", "21", "GPIO0_45",      "None", -1}
-    },
-    compats_am68sk
-    {
+    };
+
+    constexpr string_view compats_am68sk[] = {
         "ti,am68-sk",
         "ti,j721s2"
-    },
-    AM69_SK_PIN_DEFS
-    {
+    };
+
+    constexpr PinDefinition AM69_SK_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET  Sysfs_dir  BOARD   BCM   SOC_NAME   PWM_SysFs PWM_Id
         {2, 87, "42110000.gpio",  "3",  "2", "WKUP_GPIO0_87", "None", -1},
         {3, 65, "600000.gpio",    "5",  "3", "WKUP_GPIO0_65", "None", -1},
@@ -201,14 +158,14 @@ namespace GPIO
         {3, 27, "600000.gpio",   "37", "26", "GPIO0_27",      "None", -1},
         {3, 48, "600000.gpio",   "38", "20", "GPIO0_48",      "None", -1},
         {3, 45, "600000.gpio",   "40", "21", "GPIO0_45",      "None", -1}
-    },
-    compats_am69sk
-    {
+    };
+
+    constexpr string_view compats_am69sk[] = {
         "ti,am69-sk",
         "ti,j784s4"
-    },
-    AM62A_SK_PIN_DEFS
-    {
+    };
+
+    constexpr PinDefinition AM62A_SK_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET Sysfs_dir     BOARD   BCM   SOC_NAME      PWM_SysFs PWM_Id
         {2, 44, "600000.gpio",  "3",  "2", "I2C2_SDA", "None", -1},
         {2, 43, "600000.gpio",  "5",  "3", "I2C2_SCL", "None", -1},
@@ -236,14 +193,14 @@ namespace GPIO
         {2, 41, "600000.gpio",  "37", "26", "GPIO0_41", "None", -1},
         {3, 8, "601000.gpio",   "38", "20", "GPIO1_08", "None", -1},
         {3, 7, "601000.gpio",   "40", "21", "GPIO1_07", "None", -1}
-    },
-    compats_am62ask
-    {
+    };
+
+    constexpr string_view compats_am62ask[] = {
         "ti,am62a7-sk",
         "ti,am62a7"
-    },
-    AM62P_SK_PIN_DEFS
-    {
+    };
+
+    constexpr PinDefinition AM62P_SK_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET  Sysfs_dir     BOARD   BCM   SOC_NAME      PWM_SysFs PWM_Id
         {1, 44, "600000.gpio",  "3",  "2", "I2C2_SDA", "None", -1},
         {1, 43, "600000.gpio",  "5",  "3", "I2C2_SCL", "None", -1},
@@ -271,14 +228,14 @@ namespace GPIO
         {1, 41, "600000.gpio",  "37", "26", "GPIO0_41", "None", -1},
         {2, 8, "601000.gpio",   "38", "20", "GPIO1_08", "None", -1},
         {2, 7, "601000.gpio",   "40", "21", "GPIO1_07", "None", -1}
-    },
-    compats_am62psk
-    {
+    };
+
+    constexpr string_view compats_am62psk[] = {
         "ti,am62p5-sk",
         "ti,am62p5"
-    },
-    J722S_EVM_PIN_DEFS
-    {
+    };
+
+    constexpr PinDefinition J722S_EVM_PIN_DEFS[] = {
     //  GPIOCHIP_X  OFFSET  Sysfs_dir     BOARD   BCM   SOC_NAME      PWM_SysFs PWM_Id
         {1, 18, "4201000.gpio",  "3",  "2", "I2C2_SDA", "None", -1},
         {1, 17, "4201000.gpio",  "5",  "3", "I2C2_SCL", "None", -1},
@@ -306,189 +263,292 @@ namespace GPIO
         {2, 36, "600000.gpio",  "37", "26", "GPIO0_36", "None", -1},
         {3, 10, "601000.gpio",   "38", "20", "GPIO1_10", "None", -1},
         {3, 9, "601000.gpio",   "40", "21", "GPIO1_09", "None", -1}
-    },
-    compats_j722sevm
-    {
+    };
+
+    constexpr string_view compats_j722sevm[] = {
         "ti,j722s-evm",
         "ti,j722s"
-    },
-    PIN_DEFS_MAP
-    {
-        { J721E_SK, J721E_SK_PIN_DEFS },
-        { AM68_SK,  AM68_SK_PIN_DEFS },
-        { AM69_SK,  AM69_SK_PIN_DEFS },
-        { AM62A_SK, AM62A_SK_PIN_DEFS },
-        { AM62P_SK, AM62P_SK_PIN_DEFS },
-        { J722S_EVM, J722S_EVM_PIN_DEFS }
-    },
-    DEVICE_INFO_MAP
-    {
-        { J721E_SK, {1, "8192M", "Unknown", "J721e SK", "TI", "ARM A72"} },
-        { AM68_SK,  {1, "8192M", "Unknown", "AM68 SK", "TI", "ARM A72"} },
-        { AM69_SK,  {1, "8192M", "Unknown", "AM69 SK", "TI", "ARM A72"} },
-        { AM62A_SK,  {1, "8192M", "Unknown", "AM62A SK", "TI", "ARM A53"} },
-        { AM62P_SK,  {1, "8192M", "Unknown", "AM62P SK", "TI", "ARM A53"} },
-        { J722S_EVM,  {1, "8192M", "Unknown", "J722S SK", "TI", "ARM A53"} }
-    }
-{};
+    };
 
-    PinData get_data( )
+    // In the order the compatible strings are matched
+    constexpr BoardDefinition BOARDS[] = {
+        { J721E_SK, "J721E_SK",
+          {1, "8192M", "Unknown", "J721e SK", "TI", "ARM A72"},
+          J721E_SK_PIN_DEFS, std::size( J721E_SK_PIN_DEFS ),
+          compats_j721e, std::size( compats_j721e ) },
+        { AM68_SK, "AM68_SK",
+          {1, "8192M", "Unknown", "AM68 SK", "TI", "ARM A72"},
+          AM68_SK_PIN_DEFS, std::size( AM68_SK_PIN_DEFS ),
+          compats_am68sk, std::size( compats_am68sk ) },
+        { AM69_SK, "AM69_SK",
+          {1, "8192M", "Unknown", "AM69 SK", "TI", "ARM A72"},
+          AM69_SK_PIN_DEFS, std::size( AM69_SK_PIN_DEFS ),
+          compats_am69sk, std::size( compats_am69sk ) },
+        { AM62A_SK, "AM62A_SK",
+          {1, "8192M", "Unknown", "AM62A SK", "TI", "ARM A53"},
+          AM62A_SK_PIN_DEFS, std::size( AM62A_SK_PIN_DEFS ),
+          compats_am62ask, std::size( compats_am62ask ) },
+        { AM62P_SK, "AM62P_SK",
+          {1, "8192M", "Unknown", "AM62P SK", "TI", "ARM A53"},
+          AM62P_SK_PIN_DEFS, std::size( AM62P_SK_PIN_DEFS ),
+          compats_am62psk, std::size( compats_am62psk ) },
+        { J722S_EVM, "J722S_EVM",
+          {1, "8192M", "Unknown", "J722S SK", "TI", "ARM A53"},
+          J722S_EVM_PIN_DEFS, std::size( J722S_EVM_PIN_DEFS ),
+          compats_j722sevm, std::size( compats_j722sevm ) }
+    };
+
+    /*
+    The PWM chip directories resolved so far, keyed by PWM chip name, and
+    the board cache they are saved to when there is one
+    */
+    class PwmChipDirs
     {
-        try
+      private:
+        PwmChipDirs( ) = default;
+
+      public:
+        mutex                       lock;
+        map<string, string, less<>> dirs;
+
+        // Valid once get_data() found the board, saved only if cached
+        BoardCache                  cache;
+        bool                        cached{ false };
+
+        PwmChipDirs( const PwmChipDirs & )            = delete;
+        PwmChipDirs &operator=( const PwmChipDirs & ) = delete;
+
+        static PwmChipDirs &get_instance( )
         {
-            EntirePinData &_DATA           = EntirePinData::get_instance( );
+            static PwmChipDirs singleton{ };
+            return singleton;
+        }
 
-            const string   compatible_path = "/proc/device-tree/compatible";
+        // Write dirs to the board cache, with lock held
+        void save( )
+        {
+            if( !cached )
+            {
+                return;
+            }
 
-            set<string>    compatibles{ };
+            cache.pwm_dirs.assign( dirs.begin( ), dirs.end( ) );
+            write_board_cache( board_cache_path( ), cache );
+        }
+    };
 
-            { // scope for f:
-                ifstream     f( compatible_path );
-                stringstream buffer{ };
+    const string &resolve_pwm_chip_dir( string_view pwm_chip_name )
+    {
+        static const string none = "None";
+        if( pwm_chip_name == "None" || !_backend( ).sysfs_pwm( ) )
+        {
+            return none;
+        }
 
-                buffer << f.rdbuf( );
-                string         tmp_str = buffer.str( );
-                vector<string> _vec_compatibles( split( tmp_str, '\x00' ) );
-                // convert to std::set
-                copy( _vec_compatibles.begin( ), _vec_compatibles.end( ),
-                      inserter( compatibles, compatibles.end( ) ) );
-            } // scope ends
+        PwmChipDirs      &pwm_dirs = PwmChipDirs::get_instance( );
+        lock_guard<mutex> guard( pwm_dirs.lock );
 
-            auto matches = [&compatibles]( const vector<string> &vals ) {
-                for( const auto &v : vals )
-                {
-                    if( is_in( v, compatibles ) )
-                    {
-                        return true;
-                    }
-                }
-                return false;
-            };
+        auto              it = pwm_dirs.dirs.find( pwm_chip_name );
+        if( it != pwm_dirs.dirs.end( ) )
+        {
+            return it->second;
+        }
 
-            Model model{ };
+        const vector<string> sysfs_prefixes = {
+            "/sys/devices/", "/sys/devices/platform/",
+            "/sys/devices/platform/bus@100000/",
+            "/sys/devices/platform/bus@100000/bus@100000:bus@28380000/",
+            "/sys/devices/platform/bus@f0000/" };
 
-            if( matches( _DATA.compats_j721e ) )
+        string pwm_chip_dir = "None";
+        for( const auto &prefix : sysfs_prefixes )
+        {
+            auto d = fs_root( ) + prefix + string( pwm_chip_name );
+            if( os_path_isdir( d ) )
             {
-                model = J721E_SK;
+                pwm_chip_dir = d;
+                break;
             }
-            else if( matches( _DATA.compats_am68sk ) )
+        }
+
+        /*
+        Some PWM controllers aren't enabled in all versions of the DT.
+        In this case, just hide the PWM function on this pin, but let
+        all other aspects of the library continue to work.
+        */
+
+        string pwmchip_dir  = "None";
+        auto   chip_pwm_dir = pwm_chip_dir + "/pwm";
+        if( !is_None( pwm_chip_dir ) && os_path_exists( chip_pwm_dir ) )
+        {
+            for( const auto &fn : os_listdir( chip_pwm_dir ) )
             {
-                model = AM68_SK;
+                if( startswith( fn, "pwmchip" ) )
+                {
+                    pwmchip_dir = chip_pwm_dir + "/" + fn;
+                    break;
+                }
             }
-            else if( matches( _DATA.compats_am69sk ) )
+        }
+
+        // A chip not found yet may be enabled later, so it is searched again
+        // next time and never saved
+        if( is_None( pwmchip_dir ) )
+        {
+            return none;
+        }
+
+        const string &dir =
+            pwm_dirs.dirs.emplace( string( pwm_chip_name ), pwmchip_dir )
+                .first->second;
+        pwm_dirs.save( );
+        return dir;
+    }
+
+    // Whether the NUL separated compatible strings of the device tree hold
+    // compat
+    static bool _is_compatible( const string &compatibles, string_view compat )
+    {
+        string_view rest = compatibles;
+        while( !rest.empty( ) )
+        {
+            size_t end = rest.find( '\0' );
+            if( rest.substr( 0, end ) == compat )
             {
-                model = AM69_SK;
+                return true;
             }
-            else if( matches( _DATA.compats_am62ask ) )
+            if( end == string_view::npos )
             {
-                model = AM62A_SK;
+                break;
             }
-            else if( matches( _DATA.compats_am62psk ) )
+            rest.remove_prefix( end + 1 );
+        }
+
+        return false;
+    }
+
+    // The board named model, those of the board file first
+    static const BoardDefinition *_find_board( const string &model )
+    {
+        for( const BoardDefinition &b : board_file_boards( ) )
+        {
+            if( b.name == model )
             {
-                model = AM62P_SK;
+                return &b;
             }
-            else if( matches( _DATA.compats_j722sevm ) )
+        }
+
+        for( const BoardDefinition &b : BOARDS )
+        {
+            if( b.name == model )
             {
-                model = J722S_EVM;
+                return &b;
             }
-            else
+        }
+
+        return nullptr;
+    }
+
+    // The first of count boards with a compatible string of the device tree
+    static const BoardDefinition *_match_board( const BoardDefinition *boards,
+                                                size_t              count,
+                                                const string &compatibles )
+    {
+        for( size_t n = 0; n < count; n++ )
+        {
+            const BoardDefinition &b = boards[n];
+            for( size_t i = 0; i < b.compat_count; i++ )
             {
-                throw runtime_error( "Could not determine SOC model" );
+                if( _is_compatible( compatibles, b.compats[i] ) )
+                {
+                    return &b;
+                }
             }
+        }
 
-            vector<PinDefinition> pin_defs = _DATA.PIN_DEFS_MAP.at( model );
-            PinInfo             board_info = _DATA.DEVICE_INFO_MAP.at( model );
+        return nullptr;
+    }
 
-            map<string, string> pwm_dirs{ };
+    // The whole content of a file, empty if it can't be read
+    static string _read_file( const string &path )
+    {
+        ifstream     f( path );
+        stringstream buffer{ };
 
-            vector<string>      sysfs_prefixes = {
-                "/sys/devices/", "/sys/devices/platform/",
-                "/sys/devices/platform/bus@100000/",
-                "/sys/devices/platform/bus@100000/bus@100000:bus@28380000/",
-                "/sys/devices/platform/bus@f0000/" };
+        buffer << f.rdbuf( );
+        return buffer.str( );
+    }
 
-            set<string> pwm_chip_names{ };
-            for( const auto &x : pin_defs )
+    PinData get_data( )
+    {
+        try
+        {
+            const BoardDefinition *board = nullptr;
+
+            // A simulated backend names the board instead of the device tree
+            const string board_model = _backend( ).board_model( );
+
+            if( !board_model.empty( ) )
             {
-                if( !is_None( x.PWMSysfsDir ) )
+                board = _find_board( board_model );
+                if( board == nullptr )
                 {
-                    pwm_chip_names.insert( x.PWMSysfsDir );
+                    throw runtime_error( "Unknown board model " + board_model );
                 }
             }
-
-            for( const auto &pwm_chip_name : pwm_chip_names )
+            else
             {
-
-                string pwm_chip_dir = "None";
-                for( const auto &prefix : sysfs_prefixes )
+                PwmChipDirs      &pwm_dirs = PwmChipDirs::get_instance( );
+                lock_guard<mutex> guard( pwm_dirs.lock );
+
+                BoardCache       &cache = pwm_dirs.cache;
+                const string &root = fs_root( );
+                cache.compatible =
+                    _read_file( root + "/proc/device-tree/compatible" );
+                cache.boot_id = strip(
+                    _read_file( root + "/proc/sys/kernel/random/boot_id" ) );
+                cache.board_file = board_file_key( );
+
+                // A cache written for this device tree and board file since
+                // the last boot gives the board and its PWM chips without
+                // discovery
+                const string &cache_path = board_cache_path( );
+                pwm_dirs.cached          = !cache_path.empty( );
+                if( pwm_dirs.cached && read_board_cache( cache_path, cache ) )
                 {
-                    auto d = prefix + pwm_chip_name;
-                    if( os_path_isdir( d ) )
-                    {
-                        pwm_chip_dir = d;
-                        break;
-                    }
+                    board = _find_board( cache.model );
+                    pwm_dirs.dirs.insert( cache.pwm_dirs.begin( ),
+                                          cache.pwm_dirs.end( ) );
                 }
 
-                /*
-                Some PWM controllers aren't enabled in all versions of the DT.
-                In this case, just hide the PWM function on this pin, but let
-                all other aspects of the library continue to work.
-                */
-
-                if( is_None( pwm_chip_dir ) )
+                // The boards of the board file come before the built-in ones
+                const vector<BoardDefinition> &custom = board_file_boards( );
+                if( board == nullptr )
                 {
-                    continue;
+                    board = _match_board( custom.data( ), custom.size( ),
+                                          cache.compatible );
                 }
-
-                auto chip_pwm_dir = pwm_chip_dir + "/pwm";
-                if( !os_path_exists( chip_pwm_dir ) )
+                if( board == nullptr )
                 {
-                    continue;
+                    board = _match_board( BOARDS, std::size( BOARDS ),
+                                          cache.compatible );
                 }
 
-                for( const auto &fn : os_listdir( chip_pwm_dir ) )
+                if( board == nullptr )
                 {
-                    if( !startswith( fn, "pwmchip" ) )
-                    {
-                        continue;
-                    }
-
-                    string chip_pwm_pwmchip_dir = chip_pwm_dir + "/" + fn;
-                    pwm_dirs[pwm_chip_name]     = chip_pwm_pwmchip_dir;
-                    break;
+                    throw runtime_error( "Could not determine SOC model" );
                 }
-            }
-
-            auto model_data = [&pwm_dirs]( NumberingModes key,
-                                           const auto    &pin_defs ) {
-                auto get_or = []( const auto &dictionary, const string &x,
-                                  const string &defaultValue ) -> string {
-                    return is_in( x, dictionary ) ? dictionary.at( x )
-                                                  : defaultValue;
-                };
 
-                map<string, ChannelInfo> ret{ };
-
-                for( const auto &x : pin_defs )
+                if( cache.model != board->name )
                 {
-
-                    string pinName = x.PinName( key );
-                    ret.insert(
-                        { pinName, ChannelInfo{ pinName, x.gpiochip, x.LinuxPin,
-                                                get_or( pwm_dirs, x.PWMSysfsDir,
-                                                        "None" ),
-                                                x.PWMID } } );
+                    cache.model = string( board->name );
+                    pwm_dirs.dirs.clear( );
+                    pwm_dirs.save( );
                 }
-                return ret;
-            };
-
-            map<NumberingModes, map<string, ChannelInfo>> channel_data = {
-                { BOARD, model_data( BOARD, pin_defs ) },
-                { BCM, model_data( BCM, pin_defs ) },
-                { SOC, model_data( SOC, pin_defs ) } };
+            }
 
-            return { model, board_info, channel_data };
+            return { board->model, board->name, board->pin_info,
+                     board->pin_defs, board->pin_count };
         }
         catch( exception &e )
         {
@@ -498,4 +558,21 @@ namespace GPIO
         }
     }
 
+    map<string, ChannelInfo> get_channel_data( const PinData &data,
+                                               NumberingModes key )
+    {
+        map<string, ChannelInfo> channels{ };
+
+        // Built in place, one ChannelInfo per pin
+        const PinDefinition *pin_defs_end = data.pin_defs + data.pin_count;
+        for( const PinDefinition *x = data.pin_defs; x != pin_defs_end; x++ )
+        {
+            string pinName( x->PinName( key ) );
+            channels.try_emplace( pinName, pinName, x->gpiochip, x->LinuxPin,
+                                  x->PWMSysfsDir, x->PWMID );
+        }
+
+        return channels;
+    }
+
 } // namespace GPIO
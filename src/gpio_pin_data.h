@@ -28,32 +28,37 @@ DEALINGS IN THE SOFTWARE.
 #define GPIO_PIN_DATA_H
 
 // Standard headers
-#include <fstream>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Interface headers
 #include <GPIO.h>
 
 // Local headers
+#include "gpio_pwm_sysfs.h"
 #include "model.h"
 
 namespace GPIO
 {
+    /*
+    A row of the pin table of a board. The tables are constexpr arrays, the
+    names point to string literals so nothing is built at startup.
+    */
     struct PinDefinition
     {
-        const int          gpiochip;    // GPIO chip no
-        const unsigned int LinuxPin;    // Linux GPIO pin number
-        const std::string  SysfsDir;    // GPIO chip sysfs directory
-        const std::string  BoardPin;    // Pin number (BOARD mode)
-        const std::string  BCMPin;      // Pin number (BCM mode)
-        const std::string  SOCPin;      // Pin name (SOC mode)
-        const std::string  PWMSysfsDir; // PWM chip sysfs directory
-        const int          PWMID;       // PWM ID within PWM chip
-
-        std::string        PinName( GPIO::NumberingModes key ) const
+        const int              gpiochip;    // GPIO chip no
+        const unsigned int     LinuxPin;    // Linux GPIO pin number
+        const std::string_view SysfsDir;    // GPIO chip sysfs directory
+        const std::string_view BoardPin;    // Pin number (BOARD mode)
+        const std::string_view BCMPin;      // Pin number (BCM mode)
+        const std::string_view SOCPin;      // Pin name (SOC mode)
+        const std::string_view PWMSysfsDir; // PWM chip sysfs directory
+        const int              PWMID;       // PWM ID within PWM chip
+
+        constexpr std::string_view PinName( GPIO::NumberingModes key ) const
         {
             if( key == GPIO::BOARD )
             {
@@ -72,48 +77,77 @@ namespace GPIO
 
     struct PinInfo
     {
-        const int         P1_REVISION;
-        const std::string RAM;
-        const std::string REVISION;
-        const std::string TYPE;
-        const std::string MANUFACTURER;
-        const std::string PROCESSOR;
+        const int              P1_REVISION;
+        const std::string_view RAM;
+        const std::string_view REVISION;
+        const std::string_view TYPE;
+        const std::string_view MANUFACTURER;
+        const std::string_view PROCESSOR;
     };
 
+    // A supported board: its pin table and the device tree compatible
+    // strings identifying it. Boards of a board file are CUSTOM models.
+    struct BoardDefinition
+    {
+        const Model                   model;
+        const std::string_view        name;
+        const PinInfo                 pin_info;
+        const PinDefinition          *pin_defs;
+        const size_t                  pin_count;
+        const std::string_view       *compats;
+        const size_t                  compat_count;
+    };
+
+    /*
+    The sysfs directory of the PWM chip named pwm_chip_name, "None" if it
+    has none or isn't enabled in the device tree. Sysfs is only searched
+    until the chip is found, a missing chip is looked for on every call.
+    */
+    const std::string &resolve_pwm_chip_dir( std::string_view pwm_chip_name );
+
     struct ChannelInfo
     {
         const std::string             channel;
         const int                     chip_gpio;
         const unsigned int            gpio;
-        const std::string             pwm_chip_dir;
+        const std::string_view        pwm_chip_name;
         const int                     pwm_id;
 
-        std::shared_ptr<std::fstream> f_direction;
-        std::shared_ptr<std::fstream> f_value;
-        std::shared_ptr<std::fstream> f_duty_cycle;
+        // nullptr unless the pin has a PWM chip
+        std::shared_ptr<PwmFiles>     pwm_files;
 
         ChannelInfo( const std::string &channel, int chip_gpio,
-                     unsigned int gpio, const std::string &pwm_chip_dir,
+                     unsigned int gpio, std::string_view pwm_chip_name,
                      int pwm_id )
             : channel( channel ), chip_gpio( chip_gpio ), gpio( gpio ),
-              pwm_chip_dir( pwm_chip_dir ), pwm_id( pwm_id ),
-              f_direction( std::make_shared<std::fstream>( ) ),
-              f_value( std::make_shared<std::fstream>( ) ),
-              f_duty_cycle( std::make_shared<std::fstream>( ) )
+              pwm_chip_name( pwm_chip_name ), pwm_id( pwm_id ),
+              pwm_files( pwm_chip_name != "None"
+                             ? std::make_shared<PwmFiles>( )
+                             : nullptr )
         {
         }
+
+        const std::string &pwm_chip_dir( ) const
+        {
+            return resolve_pwm_chip_dir( pwm_chip_name );
+        }
     };
 
     struct PinData
     {
-        Model   model;
-        PinInfo pin_info;
-        std::map<GPIO::NumberingModes, std::map<std::string, ChannelInfo>>
-            channel_data;
+        Model                model;
+        std::string_view     model_name;
+        PinInfo              pin_info;
+        const PinDefinition *pin_defs; // of the board, never freed
+        size_t               pin_count;
     };
 
     PinData get_data( );
 
+    // Lookup table of the channels of the board in numbering mode key
+    std::map<std::string, ChannelInfo> get_channel_data( const PinData &data,
+                                                         NumberingModes key );
+
 } // namespace GPIO
 
 #endif // GPIO_PIN_DATA_H
@@ -49,6 +49,8 @@ namespace GPIO
         virtual void stop( )                            = 0;
         virtual void _reconfigure( int frequency_hz, double duty_cycle_percent,
                                    bool start = false ) = 0;
+        virtual PwmStats stats( ) const { return PwmStats{ }; }
+        virtual void     reset_stats( ) {}
         virtual ~GpioPwmIf( ){ };
 
       public:
@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Standard headers
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+// Local headers
+#include "gpio_pwm_sysfs.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    SysfsAttr::~SysfsAttr( )
+    {
+        close( );
+    }
+
+    void SysfsAttr::open( const string &path )
+    {
+        close( );
+
+        m_fd = ::open( path.c_str( ), O_RDWR | O_CLOEXEC );
+        if( m_fd == -1 )
+        {
+            throw runtime_error( "Can't open " + path + ": " +
+                                 strerror( errno ) );
+        }
+        m_path = path;
+
+        char    buffer[32];
+        ssize_t len = pread( m_fd, buffer, sizeof( buffer ) - 1, 0 );
+        if( len > 0 )
+        {
+            buffer[len] = '\0';
+            m_cached    = strtoll( buffer, nullptr, 10 );
+        }
+    }
+
+    void SysfsAttr::close( )
+    {
+        if( m_fd != -1 )
+        {
+            ::close( m_fd );
+            m_fd = -1;
+        }
+        m_cached = -1;
+    }
+
+    void SysfsAttr::write( long long value )
+    {
+        if( value == m_cached )
+        {
+            return;
+        }
+
+        if( m_fd == -1 )
+        {
+            throw runtime_error( "PWM sysfs attribute is not open" );
+        }
+
+        char   buffer[24];
+        auto   result = to_chars( buffer, buffer + sizeof( buffer ), value );
+        size_t len    = result.ptr - buffer;
+
+        if( pwrite( m_fd, buffer, len, 0 ) != ssize_t( len ) )
+        {
+            // The kernel state is unknown after a rejected write
+            m_cached = -1;
+            throw runtime_error( "Can't write " + to_string( value ) + " to " +
+                                 m_path + ": " + strerror( errno ) );
+        }
+
+        m_cached = value;
+    }
+
+} // namespace GPIO
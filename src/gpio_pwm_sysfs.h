@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_PWM_SYSFS_H
+#define GPIO_PWM_SYSFS_H
+
+// Standard headers
+#include <string>
+
+namespace GPIO
+{
+    /*
+    Numeric sysfs attribute kept open for the life of a hardware PWM.
+    Values are formatted on the stack and written with pwrite(). The last
+    value is cached, so writing it again does nothing and the attribute
+    never has to be read back. The cache is seeded by reading the attribute
+    once when it is opened.
+    */
+    class SysfsAttr
+    {
+      public:
+        SysfsAttr( ) = default;
+        ~SysfsAttr( );
+
+        SysfsAttr( const SysfsAttr & )            = delete;
+        SysfsAttr &operator=( const SysfsAttr & ) = delete;
+
+        void      open( const std::string &path );
+        void      close( );
+        bool      is_open( ) const { return m_fd != -1; }
+
+        // Write value, unless it is the value the attribute already holds
+        void      write( long long value );
+
+        // Last value written or read, -1 if unknown
+        long long cached( ) const { return m_cached; }
+
+      private:
+        int         m_fd{ -1 };
+        long long   m_cached{ -1 };
+        std::string m_path;
+    };
+
+    // Attributes of an exported hardware PWM, shared through ChannelInfo
+    struct PwmFiles
+    {
+        SysfsAttr period;
+        SysfsAttr duty_cycle;
+        SysfsAttr enable;
+    };
+
+} // namespace GPIO
+
+#endif // GPIO_PWM_SYSFS_H
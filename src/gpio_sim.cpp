@@ -0,0 +1,191 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+// Standard headers
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+#include <GPIO_sim.h>
+
+// Local headers
+#include "gpio_backend_sim.h"
+#include "gpio_common.h"
+
+using namespace std;
+
+namespace GPIO
+{
+    namespace sim
+    {
+        static GpioBackendSim &_sim( )
+        {
+            GpioBackendSim *backend = GpioBackendSim::get_instance( );
+            if( backend == nullptr )
+            {
+                throw runtime_error( "The simulated GPIO backend is not in "
+                                     "use, set TI_GPIO_BACKEND=sim" );
+            }
+            return *backend;
+        }
+
+        bool enabled( )
+        {
+            return GpioBackendSim::get_instance( ) != nullptr;
+        }
+
+        void set_input( const string &channel, int value )
+        {
+            try
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                _sim( ).set_input( ch_info.chip_gpio, ch_info.gpio, value );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::set_input())" << endl;
+                terminate( );
+            }
+        }
+
+        void set_input( int channel, int value )
+        {
+            set_input( to_string( channel ), value );
+        }
+
+        void play( const string &channel, const vector<WaveformStep> &steps,
+                   bool repeat )
+        {
+            try
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                _sim( ).play( ch_info.chip_gpio, ch_info.gpio, steps, repeat );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::play())" << endl;
+                terminate( );
+            }
+        }
+
+        void play( int channel, const vector<WaveformStep> &steps, bool repeat )
+        {
+            play( to_string( channel ), steps, repeat );
+        }
+
+        void stop( const string &channel )
+        {
+            try
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                _sim( ).stop( ch_info.chip_gpio, ch_info.gpio );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::stop())" << endl;
+                terminate( );
+            }
+        }
+
+        void stop( int channel )
+        {
+            stop( to_string( channel ) );
+        }
+
+        void wait_waveforms( )
+        {
+            try
+            {
+                _sim( ).wait_waveforms( );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::wait_waveforms())" << endl;
+                terminate( );
+            }
+        }
+
+        void record( const string &channel, size_t capacity )
+        {
+            try
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                _sim( ).record( ch_info.chip_gpio, ch_info.gpio, capacity );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::record())" << endl;
+                terminate( );
+            }
+        }
+
+        void record( int channel, size_t capacity )
+        {
+            record( to_string( channel ), capacity );
+        }
+
+        vector<OutputSample> recorded( const string &channel )
+        {
+            try
+            {
+                const ChannelInfo &ch_info = _channel_to_info( channel, true );
+                return _sim( ).recorded( ch_info.chip_gpio, ch_info.gpio );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::recorded())" << endl;
+                terminate( );
+            }
+        }
+
+        vector<OutputSample> recorded( int channel )
+        {
+            return recorded( to_string( channel ) );
+        }
+
+        void set_latency( const Latency &latency )
+        {
+            try
+            {
+                _sim( ).set_latency( latency );
+            }
+            catch( exception &e )
+            {
+                cerr << "[Exception] " << e.what( )
+                     << " (caught from: GPIO::sim::set_latency())" << endl;
+                terminate( );
+            }
+        }
+
+    } // namespace sim
+
+} // namespace GPIO
@@ -22,19 +22,32 @@ DEALINGS IN THE SOFTWARE.
 */
 
 // Standard headers
-#include <chrono>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 // Interface headers
 #include <GPIO.h>
 
 // Local headers
+#include "gpio_line.h"
 #include "gpio_sw_pwm.h"
+#include "gpio_sw_pwm_scheduler.h"
 
 using namespace std;
 
 namespace GPIO
 {
+    static uint64_t _abs_diff( uint64_t a, uint64_t b )
+    {
+        return a > b ? a - b : b - a;
+    }
+
+    void GpioPwmIfSw::set_thread_options( const PwmThreadOptions &options )
+    {
+        SwPwmScheduler::get_instance( ).set_thread_options( options );
+    }
+
     GpioPwmIfSw::GpioPwmIfSw( int channel, int frequency_hz )
         : GpioPwmIf( channel, frequency_hz )
     {
@@ -51,11 +64,11 @@ namespace GPIO
 
     void GpioPwmIfSw::calculate_times( )
     {
-        // Time units in micro-seconds
-        m_on_time =
-            static_cast<long>( ( m_duty_cycle_percent * m_slicetime ) * 1000 );
+        // Time units in nano-seconds
+        m_on_time = static_cast<long>(
+            ( m_duty_cycle_percent * m_slicetime ) * 1000000 );
         m_off_time = static_cast<long>(
-            ( ( 100.0 - m_duty_cycle_percent ) * m_slicetime ) * 1000 );
+            ( ( 100.0 - m_duty_cycle_percent ) * m_slicetime ) * 1000000 );
     }
 
     void GpioPwmIfSw::start( )
@@ -67,7 +80,18 @@ namespace GPIO
             return;
         }
 
-        m_thread = thread( [this] { pwm_thread( ); } );
+        // Resolve the line once, the scheduler writes it directly
+        m_state = &_line_state( m_ch_info );
+        if( m_state->direction != OUT )
+        {
+            throw runtime_error(
+                "You must setup() the GPIO channel as an output first" );
+        }
+
+        reset_stats( );
+
+        SwPwmScheduler::get_instance( ).add( this );
+        m_started = true;
     }
 
     void GpioPwmIfSw::stop( )
@@ -76,25 +100,103 @@ namespace GPIO
 
         if( m_started )
         {
-            m_stop_thread = true;
-            m_thread.join( );
+            SwPwmScheduler::get_instance( ).remove( this );
+            m_started = false;
         }
     }
 
-    void GpioPwmIfSw::pwm_thread( )
+    void GpioPwmIfSw::advance( uint64_t written_ns )
     {
-        m_started = true;
+        long              on_time  = m_on_time;
+        long              off_time = m_off_time;
+        uint64_t          period   = on_time + off_time;
+
+        lock_guard<mutex> lock( m_timing_lock );
+
+        uint64_t late            = _abs_diff( written_ns, m_deadline );
+        m_timing.wakeup_max_late = max( m_timing.wakeup_max_late, late );
+
+        // Periods and high times only exist while both edges are written
+        if( m_value == HIGH )
+        {
+            if( m_rise != 0 && off_time > 0 )
+            {
+                uint64_t measured = written_ns - m_rise;
+                m_timing.periods++;
+                m_timing.period_sum += double( measured );
+                m_timing.period_sq_sum += double( measured ) * measured;
+                m_timing.period_max_error =
+                    max( m_timing.period_max_error,
+                         _abs_diff( measured, period ) );
+            }
+            m_rise = off_time > 0 ? written_ns : 0;
+
+            // At 100% duty cycle the level is rewritten once per period
+            m_deadline += on_time;
+            m_value = off_time > 0 ? LOW : HIGH;
+        }
+        else
+        {
+            if( m_rise != 0 && on_time > 0 )
+            {
+                uint64_t measured = written_ns - m_rise;
+                m_timing.highs++;
+                m_timing.high_sum += double( measured );
+                m_timing.high_sq_sum += double( measured ) * measured;
+                m_timing.high_max_error =
+                    max( m_timing.high_max_error,
+                         _abs_diff( measured, on_time ) );
+            }
+
+            m_deadline += off_time;
+            m_value = on_time > 0 ? HIGH : LOW;
+        }
+
+        // Start over instead of catching up after a long stall
+        if( written_ns > m_deadline + period )
+        {
+            m_timing.overruns++;
+            m_deadline = written_ns;
+            m_rise     = 0;
+        }
+    }
+
+    PwmStats GpioPwmIfSw::stats( ) const
+    {
+        lock_guard<mutex> lock( m_timing_lock );
+
+        PwmStats          result;
+        result.periods             = m_timing.periods;
+        result.overruns            = m_timing.overruns;
+        result.period_max_error_ns = m_timing.period_max_error;
+        result.high_max_error_ns   = m_timing.high_max_error;
+        result.wakeup_max_late_ns  = m_timing.wakeup_max_late;
 
-        while( m_stop_thread == false )
+        if( m_timing.periods > 0 )
         {
-            GPIO::output( m_ch_info.channel, GPIO::HIGH );
-            this_thread::sleep_for( chrono::microseconds( m_on_time ) );
+            double mean           = m_timing.period_sum / m_timing.periods;
+            result.period_mean_ns = mean;
+            result.period_stddev_ns =
+                sqrt( max( 0.0, m_timing.period_sq_sum / m_timing.periods -
+                                    mean * mean ) );
+        }
 
-            GPIO::output( m_ch_info.channel, GPIO::LOW );
-            this_thread::sleep_for( chrono::microseconds( m_off_time ) );
+        if( m_timing.highs > 0 )
+        {
+            double mean         = m_timing.high_sum / m_timing.highs;
+            result.high_mean_ns = mean;
+            result.high_stddev_ns =
+                sqrt( max( 0.0, m_timing.high_sq_sum / m_timing.highs -
+                                    mean * mean ) );
         }
 
-        m_started = false;
+        return result;
+    }
+
+    void GpioPwmIfSw::reset_stats( )
+    {
+        lock_guard<mutex> lock( m_timing_lock );
+        m_timing = Timing{ };
     }
 
     void GpioPwmIfSw::_reconfigure( int frequency_hz, double duty_cycle_percent,
@@ -115,8 +217,14 @@ namespace GPIO
 
         if( freq_change )
         {
+            if( frequency_hz <= 0 )
+            {
+                throw runtime_error( "Invalid frequency" );
+            }
+
             m_frequency_hz = frequency_hz;
             m_basetime     = 1000.0 / m_frequency_hz; // ms
+            m_slicetime    = m_basetime / 100.0;
         }
 
         m_duty_cycle_percent = duty_cycle_percent;
@@ -26,12 +26,20 @@ DEALINGS IN THE SOFTWARE.
 #define GPIO_SW_PWM_H
 
 // Standard headers
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Interface headers
+#include <GPIO.h>
 
 // Local headers
 #include "gpio_pwm_if.h"
 
 namespace GPIO
 {
+    class LineState;
+
     // SW PWM class ==========================================================
     class GpioPwmIfSw : public GpioPwmIf
     {
@@ -41,20 +49,53 @@ namespace GPIO
         void stop( ) final;
         void _reconfigure( int frequency_hz, double duty_cycle_percent,
                            bool start = false ) final;
+        PwmStats stats( ) const final;
+        void     reset_stats( ) final;
         ~GpioPwmIfSw( );
 
+        static void set_thread_options( const PwmThreadOptions &options );
+
+        /*
+        Called by the SwPwmScheduler once m_value has been written at
+        written_ns. Records the timing and moves m_deadline and m_value to
+        the next edge.
+        */
+        void        advance( uint64_t written_ns );
+
       public:
-        bool        m_stop_thread{ false };
-        double      m_basetime{ 0.0 };
-        double      m_slicetime{ 0.0 };
-        long        m_on_time{ 0L };
-        long        m_off_time{ 0L };
-        std::thread m_thread;
-        std::mutex  m_lock;
+        double            m_basetime{ 0.0 };
+        double            m_slicetime{ 0.0 };
+        // nano-seconds, read by the scheduler at every edge
+        std::atomic<long> m_on_time{ 0L };
+        std::atomic<long> m_off_time{ 0L };
+        std::mutex        m_lock;
+
+        // Scheduling state, guarded by the SwPwmScheduler lock
+        LineState        *m_state{ nullptr };
+        uint64_t          m_deadline{ 0 }; // CLOCK_MONOTONIC ns of next edge
+        int               m_value{ LOW };  // value written at m_deadline
+        uint64_t          m_rise{ 0 };     // last rising edge, 0 if none
 
       private:
-        void pwm_thread( );
-        void calculate_times( );
+        // Sums of the measured times, PwmStats is derived from them
+        struct Timing
+        {
+            uint64_t periods{ 0 };
+            uint64_t overruns{ 0 };
+            double   period_sum{ 0.0 };
+            double   period_sq_sum{ 0.0 };
+            uint64_t period_max_error{ 0 };
+            uint64_t highs{ 0 };
+            double   high_sum{ 0.0 };
+            double   high_sq_sum{ 0.0 };
+            uint64_t high_max_error{ 0 };
+            uint64_t wakeup_max_late{ 0 };
+        };
+
+        void               calculate_times( );
+
+        Timing             m_timing;
+        mutable std::mutex m_timing_lock;
     };
 
 } // namespace GPIO
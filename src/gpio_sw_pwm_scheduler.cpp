@@ -0,0 +1,305 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_line.h"
+#include "gpio_sw_pwm.h"
+#include "gpio_sw_pwm_scheduler.h"
+
+// Edges due within this time of the earliest one are written together
+#define SW_PWM_SLACK_NS 2000
+
+using namespace std;
+
+namespace GPIO
+{
+    // Orders the heap on the earliest deadline
+    static bool _later( const GpioPwmIfSw *a, const GpioPwmIfSw *b )
+    {
+        return a->m_deadline > b->m_deadline;
+    }
+
+    static void _apply_thread_options( const PwmThreadOptions &options )
+    {
+        if( options.priority > 0 )
+        {
+            sched_param param{ };
+            param.sched_priority = options.priority;
+
+            int err = pthread_setschedparam( pthread_self( ), SCHED_FIFO,
+                                             &param );
+            if( err != 0 )
+            {
+                cerr << "[WARNING] Could not run the software PWM thread with "
+                        "SCHED_FIFO priority "
+                     << options.priority << ": " << strerror( err ) << endl;
+            }
+        }
+
+        if( options.cpu >= 0 )
+        {
+            cpu_set_t cpus;
+            CPU_ZERO( &cpus );
+            CPU_SET( options.cpu, &cpus );
+
+            int err = pthread_setaffinity_np( pthread_self( ), sizeof( cpus ),
+                                              &cpus );
+            if( err != 0 )
+            {
+                cerr << "[WARNING] Could not pin the software PWM thread to "
+                        "CPU "
+                     << options.cpu << ": " << strerror( err ) << endl;
+            }
+        }
+    }
+
+    SwPwmScheduler &SwPwmScheduler::get_instance( )
+    {
+        static SwPwmScheduler singleton{ };
+        return singleton;
+    }
+
+    SwPwmScheduler::~SwPwmScheduler( )
+    {
+        {
+            lock_guard<mutex> lock( m_lock );
+            m_heap.clear( );
+        }
+        m_wake.notify_all( );
+
+        if( m_thread.joinable( ) )
+        {
+            m_thread.join( );
+        }
+    }
+
+    uint64_t SwPwmScheduler::now_ns( )
+    {
+        timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return uint64_t( ts.tv_sec ) * 1000000000ULL + ts.tv_nsec;
+    }
+
+    void SwPwmScheduler::set_thread_options( const PwmThreadOptions &options )
+    {
+        lock_guard<mutex> lock( m_lock );
+        m_options = options;
+    }
+
+    void SwPwmScheduler::add( GpioPwmIfSw *pwm )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        pwm->m_deadline = now_ns( );
+        pwm->m_value    = pwm->m_on_time > 0 ? HIGH : LOW;
+        pwm->m_rise     = 0;
+
+        m_heap.push_back( pwm );
+        push_heap( m_heap.begin( ), m_heap.end( ), _later );
+
+        m_due.reserve( m_heap.size( ) );
+        m_states.reserve( m_heap.size( ) );
+        m_uses.reserve( m_heap.size( ) );
+        m_offsets.reserve( m_heap.size( ) );
+        m_values.reserve( m_heap.size( ) );
+
+        if( !m_running )
+        {
+            // The previous thread ran out of channels and has exited
+            if( m_thread.joinable( ) )
+            {
+                m_thread.join( );
+            }
+
+            m_running = true;
+            m_thread  = thread( [this] { run( ); } );
+        }
+
+        m_wake.notify_all( );
+    }
+
+    void SwPwmScheduler::remove( GpioPwmIfSw *pwm )
+    {
+        lock_guard<mutex> lock( m_lock );
+
+        auto it = find( m_heap.begin( ), m_heap.end( ), pwm );
+        if( it == m_heap.end( ) )
+        {
+            return;
+        }
+
+        m_heap.erase( it );
+        make_heap( m_heap.begin( ), m_heap.end( ), _later );
+
+        m_wake.notify_all( );
+    }
+
+    void SwPwmScheduler::run( )
+    {
+        unique_lock<mutex> lock( m_lock );
+
+        _apply_thread_options( m_options );
+
+        while( !m_heap.empty( ) )
+        {
+            uint64_t deadline = m_heap.front( )->m_deadline;
+            if( now_ns( ) + SW_PWM_SLACK_NS < deadline )
+            {
+                // steady_clock is CLOCK_MONOTONIC, so this is an absolute
+                // deadline that add() and remove() can interrupt
+                chrono::steady_clock::time_point wake_time{
+                    chrono::nanoseconds( deadline ) };
+                m_wake.wait_until( lock, wake_time );
+                continue;
+            }
+
+            write_edges( );
+        }
+
+        m_running = false;
+    }
+
+    /*
+    Pop every edge due now, write them with one call per line request, and
+    push the channels back with the time of their next edge. The lines are
+    entered first, so their request can't be reconfigured or replaced while
+    written.
+    */
+    void SwPwmScheduler::write_edges( )
+    {
+        uint64_t limit = now_ns( ) + SW_PWM_SLACK_NS;
+
+        m_due.clear( );
+        while( !m_heap.empty( ) && m_heap.front( )->m_deadline <= limit )
+        {
+            pop_heap( m_heap.begin( ), m_heap.end( ), _later );
+            m_due.push_back( m_heap.back( ) );
+            m_heap.pop_back( );
+        }
+
+        m_states.clear( );
+        for( GpioPwmIfSw *pwm : m_due )
+        {
+            m_states.push_back( pwm->m_state );
+        }
+        _enter_lines( m_states, m_uses );
+
+        sort( m_due.begin( ), m_due.end( ),
+              []( const GpioPwmIfSw *a, const GpioPwmIfSw *b ) {
+                  return a->m_state->request < b->m_state->request;
+              } );
+
+        for( size_t first = 0; first < m_due.size( ); )
+        {
+            BackendRequest *request = m_due[first]->m_state->request;
+
+            m_offsets.clear( );
+            m_values.clear( );
+
+            // Set up as an input or cleaned up since the PWM started
+            size_t last = first;
+            for( ; last < m_due.size( ) &&
+                   m_due[last]->m_state->request == request;
+                 last++ )
+            {
+                if( m_due[last]->m_state->direction.load(
+                        memory_order_acquire ) == OUT )
+                {
+                    m_offsets.push_back( m_due[last]->m_state->offset );
+                    m_values.push_back( m_due[last]->m_value );
+                }
+            }
+
+            // Another writer of the lines can't come between the write and
+            // their driven values
+            unique_lock<mutex> lock{ };
+            if( !m_offsets.empty( ) )
+            {
+                lock = unique_lock<mutex>(
+                    m_due[first]->m_state->line_request->write_lock );
+            }
+
+            int status = 0;
+            if( m_offsets.size( ) == 1 )
+            {
+                status = request->set_value( m_offsets[0], m_values[0] );
+            }
+            else if( m_offsets.size( ) > 1 )
+            {
+                status = request->set_values(
+                    m_offsets.size( ), m_offsets.data( ), m_values.data( ) );
+            }
+
+            for( size_t i = first; i < last; i++ )
+            {
+                LineState *state = m_due[i]->m_state;
+                if( state->direction.load( memory_order_relaxed ) == OUT )
+                {
+                    state->driven.store( status == -1 ? -1 : m_due[i]->m_value,
+                                         memory_order_relaxed );
+                }
+            }
+            if( lock.owns_lock( ) )
+            {
+                lock.unlock( );
+            }
+
+            if( status == -1 )
+            {
+                cerr << "[Exception] Could not set the software PWM output of "
+                        "channel "
+                     << m_due[first]->m_ch_info.channel
+                     << " (caught from: SwPwmScheduler::write_edges())"
+                     << endl;
+            }
+
+            uint64_t written = now_ns( );
+            for( size_t i = first; i < last; i++ )
+            {
+                m_due[i]->advance( written );
+            }
+
+            first = last;
+        }
+
+        m_uses.clear( );
+        for( GpioPwmIfSw *pwm : m_due )
+        {
+            m_heap.push_back( pwm );
+            push_heap( m_heap.begin( ), m_heap.end( ), _later );
+        }
+    }
+
+} // namespace GPIO
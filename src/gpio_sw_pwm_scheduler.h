@@ -0,0 +1,100 @@
+/*
+Copyright (c) 2026, Texas Instruments Incorporated. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+#ifndef GPIO_SW_PWM_SCHEDULER_H
+#define GPIO_SW_PWM_SCHEDULER_H
+
+// Standard headers
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Interface headers
+#include <GPIO.h>
+
+// Local headers
+#include "gpio_line.h"
+
+namespace GPIO
+{
+    class GpioPwmIfSw;
+
+    /*
+    Single thread running every software PWM channel. The channels are kept
+    in a min-heap ordered by the time of their next edge, and the thread
+    sleeps until the earliest one. Edges falling due together are written
+    with one backend call per line request, so the cost depends on the number
+    of edges per second rather than on the number of channels. The lines
+    are entered with a LineUse while written, and a line that is no longer
+    an output, reconfigured or cleaned up meanwhile, is skipped.
+    The thread exits when the last channel is removed.
+    */
+    class SwPwmScheduler
+    {
+      public:
+        SwPwmScheduler( const SwPwmScheduler & )            = delete;
+        SwPwmScheduler &operator=( const SwPwmScheduler & ) = delete;
+        ~SwPwmScheduler( );
+
+        static SwPwmScheduler &get_instance( );
+
+        // Start driving the channel, its first edge is written right away
+        void add( GpioPwmIfSw *pwm );
+
+        // Stop driving the channel. Once this returns the line is no longer
+        // written by the scheduler.
+        void remove( GpioPwmIfSw *pwm );
+
+        // Used the next time the scheduler thread starts
+        void set_thread_options( const PwmThreadOptions &options );
+
+        static uint64_t now_ns( );
+
+      private:
+        SwPwmScheduler( ) = default;
+        void run( );
+        void write_edges( );
+
+      private:
+        std::mutex                    m_lock;
+        std::condition_variable       m_wake;
+        std::thread                   m_thread;
+        bool                          m_running{ false };
+        PwmThreadOptions           m_options;
+
+        // Min-heap on GpioPwmIfSw::m_deadline
+        std::vector<GpioPwmIfSw *> m_heap;
+
+        // Edges being written, kept to avoid allocating on every wake up
+        std::vector<GpioPwmIfSw *> m_due;
+        std::vector<LineState *>   m_states;
+        std::vector<LineUse>       m_uses;
+        std::vector<unsigned int>  m_offsets;
+        std::vector<int>           m_values;
+    };
+
+} // namespace GPIO
+
+#endif // GPIO_SW_PWM_SCHEDULER_H
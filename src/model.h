@@ -27,8 +27,6 @@ DEALINGS IN THE SOFTWARE.
 #ifndef MODEL_H
 #define MODEL_H
 
-#include <string>
-
 // SOC Models
 enum class Model
 {
@@ -37,7 +35,8 @@ enum class Model
     AM69_SK,
     AM62A_SK,
     AM62P_SK,
-    J722S_EVM
+    J722S_EVM,
+    CUSTOM // described by the board file
 };
 
 // alias
@@ -47,37 +46,6 @@ constexpr Model    AM69_SK  = Model::AM69_SK;
 constexpr Model    AM62A_SK = Model::AM62A_SK;
 constexpr Model    AM62P_SK = Model::AM62P_SK;
 constexpr Model    J722S_EVM = Model::J722S_EVM;
-
-static std::string ModelToString( Model m )
-{
-    if( m == Model::J721E_SK )
-    {
-        return "J721E_SK";
-    }
-    else if( m == Model::AM68_SK )
-    {
-        return "AM68_SK";
-    }
-    else if( m == Model::AM69_SK )
-    {
-        return "AM69_SK";
-    }
-    else if( m == Model::AM62A_SK )
-    {
-        return "AM62A_SK";
-    }
-    else if( m == Model::AM62P_SK )
-    {
-        return "AM62P_SK";
-    }
-    else if( m == Model::J722S_EVM )
-    {
-        return "J722S_EVM";
-    }
-    else
-    {
-        return "None";
-    }
-}
+constexpr Model    CUSTOM    = Model::CUSTOM;
 
 #endif